@@ -25,10 +25,13 @@ void AglTFRuntimeOBJAssetActor::BeginPlay()
 
 	TArray<FString> ObjectNames = UglTFRuntimeOBJFunctionLibrary::GetOBJObjectNames(Asset);
 
+	const FglTFRuntimeStaticMeshConfig LODsStaticMeshConfig = UglTFRuntimeOBJFunctionLibrary::GetOBJStaticMeshConfigForLODs(StaticMeshConfig, OBJConfig);
+
 	for (const FString& ObjectName : ObjectNames)
 	{
-		FglTFRuntimeMeshLOD LOD;
-		if (UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLOD(Asset, ObjectName, LOD, StaticMeshConfig.MaterialsConfig))
+		// shared with the asset cache, actors spawned from the same asset do not copy the meshes
+		FglTFRuntimeOBJSharedMeshLODs LODs = UglTFRuntimeOBJFunctionLibrary::LoadOBJAsSharedRuntimeLODs(Asset, ObjectName, StaticMeshConfig.MaterialsConfig, OBJConfig);
+		if (LODs)
 		{
 			UStaticMeshComponent* StaticMeshComponent = NewObject<UStaticMeshComponent>(this, MakeUniqueObjectName(this, UStaticMeshComponent::StaticClass(), *ObjectName));
 			StaticMeshComponent->SetupAttachment(GetRootComponent());
@@ -38,7 +41,7 @@ void AglTFRuntimeOBJAssetActor::BeginPlay()
 			StaticMeshComponent->ComponentTags.Add(*FString::Printf(TEXT("glTFRuntime:NodeName:%s"), *ObjectName));
 			StaticMeshComponent->ComponentTags.Add(TEXT("glTFRuntime:Format:OBJ"));
 
-			UStaticMesh* StaticMesh = Asset->LoadStaticMeshFromRuntimeLODs({ LOD }, StaticMeshConfig);
+			UStaticMesh* StaticMesh = Asset->LoadStaticMeshFromRuntimeLODs(*LODs, LODsStaticMeshConfig);
 			if (StaticMesh)
 			{
 				StaticMeshComponent->SetStaticMesh(StaticMesh);
@@ -11,6 +11,10 @@ AglTFRuntimeOBJAssetActorAsync::AglTFRuntimeOBJAssetActorAsync()
 
 	AssetRoot = CreateDefaultSubobject<USceneComponent>(TEXT("AssetRoot"));
 	RootComponent = AssetRoot;
+
+	MaxConcurrentLoads = 0;
+	StreamingBatchTriangles = 0;
+	NumLoadsInFlight = 0;
 }
 
 // Called when the game starts or when spawned
@@ -44,21 +48,28 @@ void AglTFRuntimeOBJAssetActorAsync::ReceiveOnScenesLoaded_Implementation()
 
 }
 
-void AglTFRuntimeOBJAssetActorAsync::LoadNextMeshAsync()
+void AglTFRuntimeOBJAssetActorAsync::LoadNextMeshesAsync()
 {
-	if (MeshesToLoad.Num() == 0)
-	{
-		return;
-	}
+	const int32 MaxLoads = MaxConcurrentLoads > 0 ? MaxConcurrentLoads : FMath::Max(FPlatformMisc::NumberOfCores(), 1);
 
-	auto It = MeshesToLoad.CreateIterator();
-	if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(It->Key))
+	while (MeshesToLoad.Num() > 0 && NumLoadsInFlight < MaxLoads)
 	{
-		CurrentPrimitiveComponent = StaticMeshComponent;
-		FglTFRuntimeMeshLODAsync Delegate;
-		Delegate.BindDynamic(this, &AglTFRuntimeOBJAssetActorAsync::LoadStaticMeshAsync);
+		UStaticMeshComponent* StaticMeshComponent = MeshesToLoad[0].Key;
+		const FString ObjectName = MeshesToLoad[0].Value;
+		MeshesToLoad.RemoveAt(0);
 
-		UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODAsync(Asset, It->Value, Delegate, StaticMeshConfig.MaterialsConfig);
+		NumLoadsInFlight++;
+
+		if (StreamingBatchTriangles > 0)
+		{
+			FglTFRuntimeOBJMeshLODBatchNativeAsync Delegate = FglTFRuntimeOBJMeshLODBatchNativeAsync::CreateUObject(this, &AglTFRuntimeOBJAssetActorAsync::LoadStaticMeshBatchAsync, StaticMeshComponent);
+			UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODStreamingNativeAsync(Asset, ObjectName, Delegate, StreamingBatchTriangles, StaticMeshConfig.MaterialsConfig, OBJConfig);
+		}
+		else
+		{
+			FglTFRuntimeOBJMeshLODsNativeAsync Delegate = FglTFRuntimeOBJMeshLODsNativeAsync::CreateUObject(this, &AglTFRuntimeOBJAssetActorAsync::LoadStaticMeshAsync, StaticMeshComponent);
+			UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODsNativeAsync(Asset, ObjectName, Delegate, StaticMeshConfig.MaterialsConfig, OBJConfig);
+		}
 	}
 }
 
@@ -70,7 +81,7 @@ void AglTFRuntimeOBJAssetActorAsync::LoadObjectsAsync(const TArray<FString>& Nam
 		StaticMeshComponent->SetupAttachment(GetRootComponent());
 		StaticMeshComponent->RegisterComponent();
 		AddInstanceComponent(StaticMeshComponent);
-		MeshesToLoad.Add(StaticMeshComponent, ObjectName);
+		MeshesToLoad.Add(TPair<UStaticMeshComponent*, FString>(StaticMeshComponent, ObjectName));
 
 		StaticMeshComponent->ComponentTags.Add(*FString::Printf(TEXT("glTFRuntime:NodeName:%s"), *ObjectName));
 		StaticMeshComponent->ComponentTags.Add(TEXT("glTFRuntime:Format:OBJ"));
@@ -82,31 +93,74 @@ void AglTFRuntimeOBJAssetActorAsync::LoadObjectsAsync(const TArray<FString>& Nam
 	}
 	else
 	{
-		LoadNextMeshAsync();
+		LoadNextMeshesAsync();
 	}
 }
 
-void AglTFRuntimeOBJAssetActorAsync::LoadStaticMeshAsync(const bool bValid, const FglTFRuntimeMeshLOD& RuntimeLOD)
+void AglTFRuntimeOBJAssetActorAsync::LoadStaticMeshAsync(const bool bValid, const TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, UStaticMeshComponent* StaticMeshComponent)
 {
+	NumLoadsInFlight--;
+
 	if (bValid)
 	{
+		UStaticMesh* StaticMesh = Asset->LoadStaticMeshFromRuntimeLODs(RuntimeLODs, UglTFRuntimeOBJFunctionLibrary::GetOBJStaticMeshConfigForLODs(StaticMeshConfig, OBJConfig));
+		if (StaticMesh)
+		{
+			StaticMeshComponent->SetStaticMesh(StaticMesh);
+		}
+
+		ReceiveOnStaticMeshComponentCreated(StaticMeshComponent);
+	}
+
+	if (MeshesToLoad.Num() > 0)
+	{
+		LoadNextMeshesAsync();
+	}
+	// trigger event
+	else if (NumLoadsInFlight == 0)
+	{
+		ReceiveOnScenesLoaded();
+	}
+}
+
+void AglTFRuntimeOBJAssetActorAsync::LoadStaticMeshBatchAsync(const bool bValid, const FglTFRuntimeMeshLOD& RuntimeLOD, const bool bLastBatch, UStaticMeshComponent* StaticMeshComponent)
+{
+	if (bValid && RuntimeLOD.Primitives.Num() > 0)
+	{
+		// the first batch goes in the object component, the following ones in attached components
+		UStaticMeshComponent* BatchStaticMeshComponent = StaticMeshComponent;
+		if (StaticMeshComponent->GetStaticMesh())
+		{
+			BatchStaticMeshComponent = NewObject<UStaticMeshComponent>(this, MakeUniqueObjectName(this, UStaticMeshComponent::StaticClass(), StaticMeshComponent->GetFName()));
+			BatchStaticMeshComponent->SetupAttachment(StaticMeshComponent);
+			BatchStaticMeshComponent->RegisterComponent();
+			AddInstanceComponent(BatchStaticMeshComponent);
+			BatchStaticMeshComponent->ComponentTags = StaticMeshComponent->ComponentTags;
+		}
+
 		UStaticMesh* StaticMesh = Asset->LoadStaticMeshFromRuntimeLODs({ RuntimeLOD }, StaticMeshConfig);
 		if (StaticMesh)
 		{
-			CurrentPrimitiveComponent->SetStaticMesh(StaticMesh);
+			BatchStaticMeshComponent->SetStaticMesh(StaticMesh);
 		}
 
-		ReceiveOnStaticMeshComponentCreated(CurrentPrimitiveComponent);
+		ReceiveOnStaticMeshComponentCreated(BatchStaticMeshComponent);
 	}
 
-	MeshesToLoad.Remove(CurrentPrimitiveComponent);
+	if (!bLastBatch)
+	{
+		return;
+	}
+
+	NumLoadsInFlight--;
+
 	if (MeshesToLoad.Num() > 0)
 	{
-		LoadNextMeshAsync();
+		LoadNextMeshesAsync();
 	}
 	// trigger event
-	else
+	else if (NumLoadsInFlight == 0)
 	{
 		ReceiveOnScenesLoaded();
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,464 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeOBJBenchmarkCommandlet.h"
+#include "Dom/JsonObject.h"
+#include "glTFRuntimeFunctionLibrary.h"
+#include "glTFRuntimeOBJFunctionLibrary.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#if WITH_EDITOR
+DEFINE_LOG_CATEGORY_STATIC(LogglTFRuntimeOBJBenchmark, Log, All);
+
+struct FglTFRuntimeOBJBenchmarkScenario
+{
+	FString Name;
+	int32 NumObjects = 1;
+	// quads per side of each object grid
+	int32 Resolution = 1;
+	bool bNegativeIndices = false;
+	// every grid cell becomes an hexagon (alternating convex and concave ones)
+	bool bNGons = false;
+	int32 NumMaterials = 0;
+};
+
+struct FglTFRuntimeOBJBenchmarkResult
+{
+	int32 NumObjects = 0;
+	int32 NumFailures = 0;
+	double LoadAssetTime = 0;
+	double ObjectNamesTime = 0;
+	FglTFRuntimeOBJLoadStats SummedStats;
+};
+
+namespace glTFRuntimeOBJBenchmark
+{
+	void AppendLine(TArray<uint8>& Blob, const FString& Line)
+	{
+		FTCHARToUTF8 Converter(*Line);
+		Blob.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+		Blob.Add('\n');
+	}
+
+	TArray<FglTFRuntimeOBJBenchmarkScenario> GetScenarios(const int32 Scale)
+	{
+		TArray<FglTFRuntimeOBJBenchmarkScenario> Scenarios;
+
+		FglTFRuntimeOBJBenchmarkScenario ManyObjects;
+		ManyObjects.Name = "ManyObjects";
+		ManyObjects.NumObjects = 64 * Scale;
+		ManyObjects.Resolution = 16;
+		Scenarios.Add(ManyObjects);
+
+		FglTFRuntimeOBJBenchmarkScenario HugeMesh;
+		HugeMesh.Name = "HugeMesh";
+		HugeMesh.Resolution = FMath::RoundToInt(512 * FMath::Sqrt(static_cast<float>(Scale)));
+		Scenarios.Add(HugeMesh);
+
+		FglTFRuntimeOBJBenchmarkScenario NegativeIndices;
+		NegativeIndices.Name = "NegativeIndices";
+		NegativeIndices.NumObjects = 16 * Scale;
+		NegativeIndices.Resolution = 64;
+		NegativeIndices.bNegativeIndices = true;
+		Scenarios.Add(NegativeIndices);
+
+		FglTFRuntimeOBJBenchmarkScenario NGons;
+		NGons.Name = "NGons";
+		NGons.NumObjects = 16 * Scale;
+		NGons.Resolution = 64;
+		NGons.bNGons = true;
+		Scenarios.Add(NGons);
+
+		FglTFRuntimeOBJBenchmarkScenario ManyMaterials;
+		ManyMaterials.Name = "ManyMaterials";
+		ManyMaterials.NumObjects = 16 * Scale;
+		ManyMaterials.Resolution = 64;
+		ManyMaterials.NumMaterials = 256;
+		Scenarios.Add(ManyMaterials);
+
+		return Scenarios;
+	}
+
+	bool GenerateScenario(const FglTFRuntimeOBJBenchmarkScenario& Scenario, const FString& Filename)
+	{
+		TArray<uint8> Blob;
+
+		if (Scenario.NumMaterials > 0)
+		{
+			const FString MaterialFilename = FPaths::ChangeExtension(Filename, "mtl");
+
+			TArray<uint8> MaterialBlob;
+			for (int32 MaterialIndex = 0; MaterialIndex < Scenario.NumMaterials; MaterialIndex++)
+			{
+				AppendLine(MaterialBlob, FString::Printf(TEXT("newmtl Material_%d"), MaterialIndex));
+				AppendLine(MaterialBlob, FString::Printf(TEXT("Kd %.3f %.3f %.3f"), (MaterialIndex % 7) / 7.0f, (MaterialIndex % 11) / 11.0f, (MaterialIndex % 13) / 13.0f));
+				AppendLine(MaterialBlob, FString::Printf(TEXT("Ns %d"), 10 + MaterialIndex % 100));
+				AppendLine(MaterialBlob, MaterialIndex % 5 == 0 ? TEXT("d 0.5") : TEXT("d 1"));
+			}
+
+			if (!FFileHelper::SaveArrayToFile(MaterialBlob, *MaterialFilename))
+			{
+				return false;
+			}
+
+			AppendLine(Blob, FString::Printf(TEXT("mtllib %s"), *FPaths::GetCleanFilename(MaterialFilename)));
+		}
+
+		const int32 Resolution = Scenario.Resolution;
+		int32 NumVertices = 0;
+		int32 NumUVs = 0;
+		int32 NumNormals = 0;
+
+		// absolute (1-based) or relative index of an already emitted element
+		auto FormatIndex = [&](const int32 Index, const int32 NumElements) -> int32
+			{
+				return Scenario.bNegativeIndices ? Index - NumElements - 1 : Index;
+			};
+
+		for (int32 ObjectIndex = 0; ObjectIndex < Scenario.NumObjects; ObjectIndex++)
+		{
+			AppendLine(Blob, FString::Printf(TEXT("o Object_%d"), ObjectIndex));
+
+			const float OffsetX = (ObjectIndex % 16) * (Resolution + 2);
+			const float OffsetZ = (ObjectIndex / 16) * (Resolution + 2);
+
+			if (Scenario.bNGons)
+			{
+				for (int32 Y = 0; Y < Resolution; Y++)
+				{
+					for (int32 X = 0; X < Resolution; X++)
+					{
+						const bool bConcave = (X + Y) % 2 == 1;
+						for (int32 Corner = 0; Corner < 6; Corner++)
+						{
+							const float Angle = Corner * PI / 3;
+							// pushing a corner toward the center makes the hexagon concave
+							const float Radius = bConcave && Corner == 0 ? 0.1f : 0.45f;
+							AppendLine(Blob, FString::Printf(TEXT("v %.4f 0 %.4f"), OffsetX + X + 0.5f + FMath::Cos(Angle) * Radius, OffsetZ + Y + 0.5f + FMath::Sin(Angle) * Radius));
+						}
+						NumVertices += 6;
+
+						FString Face = TEXT("f");
+						for (int32 Corner = 0; Corner < 6; Corner++)
+						{
+							Face += FString::Printf(TEXT(" %d"), FormatIndex(NumVertices - 5 + Corner, NumVertices));
+						}
+						AppendLine(Blob, Face);
+					}
+				}
+				continue;
+			}
+
+			const int32 FirstVertex = NumVertices + 1;
+			for (int32 Y = 0; Y <= Resolution; Y++)
+			{
+				for (int32 X = 0; X <= Resolution; X++)
+				{
+					const float Height = FMath::Sin(X * 0.3f) * FMath::Cos(Y * 0.2f);
+					AppendLine(Blob, FString::Printf(TEXT("v %.4f %.4f %.4f"), OffsetX + X, Height, OffsetZ + Y));
+					AppendLine(Blob, FString::Printf(TEXT("vt %.4f %.4f"), static_cast<float>(X) / Resolution, static_cast<float>(Y) / Resolution));
+					AppendLine(Blob, TEXT("vn 0 1 0"));
+				}
+			}
+			NumVertices += (Resolution + 1) * (Resolution + 1);
+			NumUVs += (Resolution + 1) * (Resolution + 1);
+			NumNormals += (Resolution + 1) * (Resolution + 1);
+
+			for (int32 Y = 0; Y < Resolution; Y++)
+			{
+				if (Scenario.NumMaterials > 0)
+				{
+					AppendLine(Blob, FString::Printf(TEXT("usemtl Material_%d"), (ObjectIndex * Resolution + Y) % Scenario.NumMaterials));
+				}
+
+				for (int32 X = 0; X < Resolution; X++)
+				{
+					const int32 Corners[4] =
+					{
+						FirstVertex + Y * (Resolution + 1) + X,
+						FirstVertex + Y * (Resolution + 1) + X + 1,
+						FirstVertex + (Y + 1) * (Resolution + 1) + X + 1,
+						FirstVertex + (Y + 1) * (Resolution + 1) + X
+					};
+
+					FString Face = TEXT("f");
+					for (const int32 Corner : Corners)
+					{
+						Face += FString::Printf(TEXT(" %d/%d/%d"), FormatIndex(Corner, NumVertices), FormatIndex(Corner, NumUVs), FormatIndex(Corner, NumNormals));
+					}
+					AppendLine(Blob, Face);
+				}
+			}
+		}
+
+		return FFileHelper::SaveArrayToFile(Blob, *Filename);
+	}
+
+	int32 GetExpectedTriangles(const FglTFRuntimeOBJBenchmarkScenario& Scenario)
+	{
+		// quads are split in 2 triangles, hexagons in 4
+		return Scenario.NumObjects * Scenario.Resolution * Scenario.Resolution * (Scenario.bNGons ? 4 : 2);
+	}
+
+	UglTFRuntimeAsset* LoadAsset(const FString& Filename, const bool bMapped)
+	{
+		FglTFRuntimeConfig LoaderConfig;
+		LoaderConfig.bAsBlob = true;
+		return bMapped ? UglTFRuntimeOBJFunctionLibrary::LoadOBJAssetFromFilenameMapped(Filename, false, LoaderConfig) : UglTFRuntimeFunctionLibrary::glTFLoadAssetFromFilename(Filename, false, LoaderConfig);
+	}
+
+	// a new asset for each call, so nothing is served by the caches
+	bool LoadScenario(const FString& Filename, const bool bMapped, FglTFRuntimeOBJBenchmarkResult& Result)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		UglTFRuntimeAsset* Asset = LoadAsset(Filename, bMapped);
+		if (!Asset)
+		{
+			return false;
+		}
+
+		Result.LoadAssetTime = FPlatformTime::Seconds() - StartTime;
+
+		const double ObjectNamesStartTime = FPlatformTime::Seconds();
+		const TArray<FString> ObjectNames = UglTFRuntimeOBJFunctionLibrary::GetOBJObjectNames(Asset);
+		Result.ObjectNamesTime = FPlatformTime::Seconds() - ObjectNamesStartTime;
+
+		Result.NumObjects = ObjectNames.Num();
+
+		FglTFRuntimeOBJLoadStats& SummedStats = Result.SummedStats;
+		for (const FString& ObjectName : ObjectNames)
+		{
+			FglTFRuntimeMeshLOD RuntimeLOD;
+			FglTFRuntimeOBJLoadStats Stats;
+			if (!UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODWithStats(Asset, ObjectName, RuntimeLOD, Stats, FglTFRuntimeMaterialsConfig(), FglTFRuntimeOBJConfig()))
+			{
+				Result.NumFailures++;
+			}
+
+			SummedStats.NumVerticesBeforeDeduplication += Stats.NumVerticesBeforeDeduplication;
+			SummedStats.NumVertices += Stats.NumVertices;
+			SummedStats.NumTriangles += Stats.NumTriangles;
+			SummedStats.NumMaterials += Stats.NumMaterials;
+			// the geometry is parsed (and the material libraries loaded) by the first load
+			SummedStats.ParseTime += Stats.ParseTime;
+			SummedStats.MaterialLibrariesTime += Stats.MaterialLibrariesTime;
+			SummedStats.BuildTime += Stats.BuildTime;
+			SummedStats.FixPrimitivesTime += Stats.FixPrimitivesTime;
+			SummedStats.FillMaterialsTime += Stats.FillMaterialsTime;
+			SummedStats.TexturesTime += Stats.TexturesTime;
+			SummedStats.BuildMaterialsTime += Stats.BuildMaterialsTime;
+			SummedStats.DiskCacheTime += Stats.DiskCacheTime;
+		}
+
+		return true;
+	}
+
+	bool CheckResult(const FglTFRuntimeOBJBenchmarkScenario& Scenario, const FglTFRuntimeOBJBenchmarkResult& Result, FString& Error)
+	{
+		if (Result.NumFailures > 0)
+		{
+			Error = FString::Printf(TEXT("%s: %d objects failed to load"), *Scenario.Name, Result.NumFailures);
+			return false;
+		}
+
+		if (Result.NumObjects != Scenario.NumObjects)
+		{
+			Error = FString::Printf(TEXT("%s: expected %d objects, got %d"), *Scenario.Name, Scenario.NumObjects, Result.NumObjects);
+			return false;
+		}
+
+		const int32 ExpectedTriangles = GetExpectedTriangles(Scenario);
+		if (Result.SummedStats.NumTriangles != ExpectedTriangles)
+		{
+			Error = FString::Printf(TEXT("%s: expected %d triangles, got %d"), *Scenario.Name, ExpectedTriangles, Result.SummedStats.NumTriangles);
+			return false;
+		}
+
+		return true;
+	}
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FglTFRuntimeOBJBenchmarkScenariosTest, "glTFRuntimeOBJ.Benchmark.Scenarios", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FglTFRuntimeOBJBenchmarkScenariosTest::RunTest(const FString& Parameters)
+{
+	const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("glTFRuntimeOBJBenchmark"), TEXT("Tests"));
+
+	for (FglTFRuntimeOBJBenchmarkScenario Scenario : glTFRuntimeOBJBenchmark::GetScenarios(1))
+	{
+		// same features as the benchmark, at a fraction of the size
+		Scenario.NumObjects = FMath::Min(Scenario.NumObjects, 4);
+		Scenario.Resolution = FMath::Min(Scenario.Resolution, 8);
+
+		const FString Filename = FPaths::Combine(Directory, Scenario.Name + TEXT(".obj"));
+		if (!glTFRuntimeOBJBenchmark::GenerateScenario(Scenario, Filename))
+		{
+			AddError(FString::Printf(TEXT("Unable to generate %s"), *Filename));
+			continue;
+		}
+
+		for (const bool bMapped : { false, true })
+		{
+			FglTFRuntimeOBJBenchmarkResult Result;
+			FString Error;
+			if (!glTFRuntimeOBJBenchmark::LoadScenario(Filename, bMapped, Result))
+			{
+				AddError(FString::Printf(TEXT("Unable to load %s"), *Filename));
+			}
+			else if (!glTFRuntimeOBJBenchmark::CheckResult(Scenario, Result, Error))
+			{
+				AddError(Error);
+			}
+		}
+	}
+
+	return true;
+}
+#endif
+#endif
+
+UglTFRuntimeOBJBenchmarkCommandlet::UglTFRuntimeOBJBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UglTFRuntimeOBJBenchmarkCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	int32 Scale = 1;
+	FParse::Value(*Params, TEXT("Scale="), Scale);
+	Scale = FMath::Max(Scale, 1);
+
+	int32 Iterations = 3;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(Iterations, 1);
+
+	const bool bMapped = FParse::Param(*Params, TEXT("Mapped"));
+
+	const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("glTFRuntimeOBJBenchmark"));
+
+	FString Output = FPaths::Combine(Directory, TEXT("Results.json"));
+	FParse::Value(*Params, TEXT("Output="), Output);
+
+	FString ScenariosFilter;
+	FParse::Value(*Params, TEXT("Scenarios="), ScenariosFilter, false);
+	TArray<FString> ScenariosNames;
+	ScenariosFilter.ParseIntoArray(ScenariosNames, TEXT(","));
+
+	TArray<TSharedPtr<FJsonValue>> JsonScenarios;
+	bool bSuccess = true;
+
+	for (const FglTFRuntimeOBJBenchmarkScenario& Scenario : glTFRuntimeOBJBenchmark::GetScenarios(Scale))
+	{
+		if (ScenariosNames.Num() > 0 && !ScenariosNames.Contains(Scenario.Name))
+		{
+			continue;
+		}
+
+		const FString Filename = FPaths::Combine(Directory, Scenario.Name + TEXT(".obj"));
+		if (!glTFRuntimeOBJBenchmark::GenerateScenario(Scenario, Filename))
+		{
+			UE_LOG(LogglTFRuntimeOBJBenchmark, Error, TEXT("Unable to generate %s"), *Filename);
+			return 1;
+		}
+
+		TSharedRef<FJsonObject> JsonScenario = MakeShared<FJsonObject>();
+		JsonScenario->SetStringField(TEXT("name"), Scenario.Name);
+		JsonScenario->SetNumberField(TEXT("bytes"), IFileManager::Get().FileSize(*Filename));
+		JsonScenario->SetBoolField(TEXT("mapped"), bMapped);
+		JsonScenario->SetNumberField(TEXT("expected_objects"), Scenario.NumObjects);
+		JsonScenario->SetNumberField(TEXT("expected_triangles"), glTFRuntimeOBJBenchmark::GetExpectedTriangles(Scenario));
+
+		TArray<TSharedPtr<FJsonValue>> JsonIterations;
+		double BestTime = TNumericLimits<double>::Max();
+		double TotalTime = 0;
+
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+
+			FglTFRuntimeOBJBenchmarkResult Result;
+			if (!glTFRuntimeOBJBenchmark::LoadScenario(Filename, bMapped, Result))
+			{
+				UE_LOG(LogglTFRuntimeOBJBenchmark, Error, TEXT("Unable to load %s"), *Filename);
+				return 1;
+			}
+
+			const double IterationTime = FPlatformTime::Seconds() - StartTime;
+			BestTime = FMath::Min(BestTime, IterationTime);
+			TotalTime += IterationTime;
+
+			FString Error;
+			const bool bValid = glTFRuntimeOBJBenchmark::CheckResult(Scenario, Result, Error);
+			if (!bValid)
+			{
+				UE_LOG(LogglTFRuntimeOBJBenchmark, Error, TEXT("%s"), *Error);
+				bSuccess = false;
+			}
+
+			const FglTFRuntimeOBJLoadStats& SummedStats = Result.SummedStats;
+
+			TSharedRef<FJsonObject> JsonIteration = MakeShared<FJsonObject>();
+			JsonIteration->SetBoolField(TEXT("valid"), bValid);
+			JsonIteration->SetNumberField(TEXT("objects"), Result.NumObjects);
+			JsonIteration->SetNumberField(TEXT("failures"), Result.NumFailures);
+			JsonIteration->SetNumberField(TEXT("vertices_before_deduplication"), SummedStats.NumVerticesBeforeDeduplication);
+			JsonIteration->SetNumberField(TEXT("vertices"), SummedStats.NumVertices);
+			JsonIteration->SetNumberField(TEXT("triangles"), SummedStats.NumTriangles);
+			JsonIteration->SetNumberField(TEXT("materials"), SummedStats.NumMaterials);
+			JsonIteration->SetNumberField(TEXT("load_asset_time"), Result.LoadAssetTime);
+			JsonIteration->SetNumberField(TEXT("object_names_time"), Result.ObjectNamesTime);
+			JsonIteration->SetNumberField(TEXT("parse_time"), SummedStats.ParseTime);
+			JsonIteration->SetNumberField(TEXT("material_libraries_time"), SummedStats.MaterialLibrariesTime);
+			JsonIteration->SetNumberField(TEXT("build_time"), SummedStats.BuildTime);
+			JsonIteration->SetNumberField(TEXT("fix_primitives_time"), SummedStats.FixPrimitivesTime);
+			JsonIteration->SetNumberField(TEXT("fill_materials_time"), SummedStats.FillMaterialsTime);
+			JsonIteration->SetNumberField(TEXT("textures_time"), SummedStats.TexturesTime);
+			JsonIteration->SetNumberField(TEXT("build_materials_time"), SummedStats.BuildMaterialsTime);
+			JsonIteration->SetNumberField(TEXT("disk_cache_time"), SummedStats.DiskCacheTime);
+			JsonIteration->SetNumberField(TEXT("total_time"), IterationTime);
+			JsonIterations.Add(MakeShared<FJsonValueObject>(JsonIteration));
+
+			UE_LOG(LogglTFRuntimeOBJBenchmark, Display, TEXT("%s [%d/%d]: %d objects, %d triangles, load %.3fs, names %.3fs, parse %.3fs, total %.3fs"), *Scenario.Name, Iteration + 1, Iterations, Result.NumObjects, SummedStats.NumTriangles, Result.LoadAssetTime, Result.ObjectNamesTime, SummedStats.ParseTime, IterationTime);
+
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		JsonScenario->SetArrayField(TEXT("iterations"), JsonIterations);
+		JsonScenario->SetNumberField(TEXT("best_time"), BestTime);
+		JsonScenario->SetNumberField(TEXT("average_time"), TotalTime / Iterations);
+		JsonScenarios.Add(MakeShared<FJsonValueObject>(JsonScenario));
+	}
+
+	TSharedRef<FJsonObject> JsonResults = MakeShared<FJsonObject>();
+	JsonResults->SetNumberField(TEXT("scale"), Scale);
+	JsonResults->SetNumberField(TEXT("cores"), FPlatformMisc::NumberOfCores());
+	JsonResults->SetArrayField(TEXT("scenarios"), JsonScenarios);
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(JsonResults, JsonWriter);
+
+	if (!FFileHelper::SaveStringToFile(Json, *Output))
+	{
+		UE_LOG(LogglTFRuntimeOBJBenchmark, Error, TEXT("Unable to write %s"), *Output);
+		return 1;
+	}
+
+	UE_LOG(LogglTFRuntimeOBJBenchmark, Display, TEXT("Results written to %s"), *Output);
+	return bSuccess ? 0 : 1;
+#else
+	UE_LOG(LogTemp, Error, TEXT("glTFRuntimeOBJBenchmark requires an editor build"));
+	return 1;
+#endif
+}
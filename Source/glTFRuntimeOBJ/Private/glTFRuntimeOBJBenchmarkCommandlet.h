@@ -0,0 +1,27 @@
+// Copyright 2023, Roberto De Ioris.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "glTFRuntimeOBJBenchmarkCommandlet.generated.h"
+
+/**
+ * Generates synthetic OBJ/MTL files and times GetOBJObjectNames and the loading of every object.
+ *
+ * UnrealEditor-Cmd <Project> -run=glTFRuntimeOBJBenchmark -nullrhi [-Scenarios=ManyObjects,HugeMesh,NegativeIndices,NGons,ManyMaterials]
+ *     [-Scale=1] [-Iterations=3] [-Mapped] [-Output=<json file>]
+ *
+ * Returns 1 when an object fails to load or the object/triangle counts differ from the generated ones.
+ * Editor builds only (the glTFRuntimeOBJ.Benchmark.Scenarios automation test runs the same checks on smaller scenarios).
+ */
+UCLASS()
+class UglTFRuntimeOBJBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UglTFRuntimeOBJBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,259 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeOBJDiskCache.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/LargeMemoryReader.h"
+
+namespace glTFRuntimeOBJ
+{
+	// "OBJC"
+	constexpr uint32 DiskCacheMagic = 0x434A424F;
+	// bump it whenever the layout changes
+	constexpr uint32 DiskCacheVersion = 3;
+
+	template<typename VectorType, int32 NumComponents>
+	void WriteVectors(FArchive& Ar, const TArray<VectorType>& Vectors)
+	{
+		int32 NumVectors = Vectors.Num();
+		Ar << NumVectors;
+
+		TArray<float> Floats;
+		Floats.SetNumUninitialized(NumVectors * NumComponents);
+		for (int32 VectorIndex = 0; VectorIndex < NumVectors; VectorIndex++)
+		{
+			for (int32 Component = 0; Component < NumComponents; Component++)
+			{
+				Floats[VectorIndex * NumComponents + Component] = static_cast<float>(Vectors[VectorIndex][Component]);
+			}
+		}
+		Ar.Serialize(Floats.GetData(), Floats.Num() * sizeof(float));
+	}
+
+	template<typename VectorType, int32 NumComponents>
+	bool ReadVectors(FArchive& Ar, TArray<VectorType>& Vectors)
+	{
+		int32 NumVectors = 0;
+		Ar << NumVectors;
+		if (Ar.IsError() || NumVectors < 0 || static_cast<int64>(NumVectors) * NumComponents * sizeof(float) > Ar.TotalSize() - Ar.Tell())
+		{
+			return false;
+		}
+
+		TArray<float> Floats;
+		Floats.SetNumUninitialized(NumVectors * NumComponents);
+		Ar.Serialize(Floats.GetData(), Floats.Num() * sizeof(float));
+
+		Vectors.SetNumUninitialized(NumVectors);
+		for (int32 VectorIndex = 0; VectorIndex < NumVectors; VectorIndex++)
+		{
+			for (int32 Component = 0; Component < NumComponents; Component++)
+			{
+				Vectors[VectorIndex][Component] = Floats[VectorIndex * NumComponents + Component];
+			}
+		}
+		return !Ar.IsError();
+	}
+
+	void WriteIndices(FArchive& Ar, const TArray<uint32>& Indices)
+	{
+		int32 NumIndices = Indices.Num();
+		Ar << NumIndices;
+		Ar.Serialize(const_cast<uint32*>(Indices.GetData()), NumIndices * sizeof(uint32));
+	}
+
+	bool ReadIndices(FArchive& Ar, TArray<uint32>& Indices)
+	{
+		int32 NumIndices = 0;
+		Ar << NumIndices;
+		if (Ar.IsError() || NumIndices < 0 || static_cast<int64>(NumIndices) * sizeof(uint32) > Ar.TotalSize() - Ar.Tell())
+		{
+			return false;
+		}
+
+		Indices.SetNumUninitialized(NumIndices);
+		Ar.Serialize(Indices.GetData(), NumIndices * sizeof(uint32));
+		return !Ar.IsError();
+	}
+
+	bool SaveRuntimeLODToDiskCache(const FString& Filename, const FglTFRuntimeMeshLOD& RuntimeLOD, const TArray<FString>& PrimitivesMaterials, const TArray<FString>& MaterialLibraries)
+	{
+		if (PrimitivesMaterials.Num() != RuntimeLOD.Primitives.Num())
+		{
+			return false;
+		}
+
+		const FString Directory = FPaths::GetPath(Filename);
+		IFileManager::Get().MakeDirectory(*Directory, true);
+
+		// write to a temporary file first, so concurrent readers never see partial files
+		const FString TempFilename = FPaths::CreateTempFilename(*Directory, TEXT("objcache"));
+		{
+			TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilename));
+			if (!Writer)
+			{
+				return false;
+			}
+
+			FArchive& Ar = *Writer;
+
+			uint32 Magic = DiskCacheMagic;
+			uint32 Version = DiskCacheVersion;
+			Ar << Magic;
+			Ar << Version;
+
+			TArray<FString> Libraries = MaterialLibraries;
+			Ar << Libraries;
+
+			int32 NumPrimitives = RuntimeLOD.Primitives.Num();
+			Ar << NumPrimitives;
+
+			for (int32 PrimitiveIndex = 0; PrimitiveIndex < NumPrimitives; PrimitiveIndex++)
+			{
+				const FglTFRuntimePrimitive& Primitive = RuntimeLOD.Primitives[PrimitiveIndex];
+
+				FString MaterialName = Primitive.MaterialName;
+				FString PrimitiveMaterial = PrimitivesMaterials[PrimitiveIndex];
+				Ar << MaterialName;
+				Ar << PrimitiveMaterial;
+
+				WriteVectors<FVector, 3>(Ar, Primitive.Positions);
+				WriteVectors<FVector, 3>(Ar, Primitive.Normals);
+				WriteVectors<FVector4, 4>(Ar, Primitive.Colors);
+				WriteVectors<FVector4, 4>(Ar, Primitive.Tangents);
+
+				int32 NumUVChannels = Primitive.UVs.Num();
+				Ar << NumUVChannels;
+				for (const TArray<FVector2D>& UVChannel : Primitive.UVs)
+				{
+					WriteVectors<FVector2D, 2>(Ar, UVChannel);
+				}
+
+				WriteIndices(Ar, Primitive.Indices);
+			}
+
+			if (!Writer->Close())
+			{
+				IFileManager::Get().Delete(*TempFilename);
+				return false;
+			}
+		}
+
+		return IFileManager::Get().Move(*Filename, *TempFilename, true);
+	}
+
+	bool LoadRuntimeLODFromDiskCache(const FString& Filename, FglTFRuntimeMeshLOD& RuntimeLOD, TArray<FString>& PrimitivesMaterials, TArray<FString>& MaterialLibraries)
+	{
+		TUniquePtr<IMappedFileHandle> MappedFileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+		if (!MappedFileHandle || MappedFileHandle->GetFileSize() <= 0)
+		{
+			return false;
+		}
+
+		TUniquePtr<IMappedFileRegion> MappedFileRegion(MappedFileHandle->MapRegion(0, MappedFileHandle->GetFileSize()));
+		if (!MappedFileRegion)
+		{
+			return false;
+		}
+
+		FLargeMemoryReader Ar(MappedFileRegion->GetMappedPtr(), MappedFileRegion->GetMappedSize());
+
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		Ar << Magic;
+		Ar << Version;
+		if (Ar.IsError() || Magic != DiskCacheMagic || Version != DiskCacheVersion)
+		{
+			return false;
+		}
+
+		Ar << MaterialLibraries;
+
+		int32 NumPrimitives = 0;
+		Ar << NumPrimitives;
+		if (Ar.IsError() || NumPrimitives < 0)
+		{
+			return false;
+		}
+
+		// nothing is written to the output until the whole file is validated (a rejected file falls back to parsing)
+		TArray<FglTFRuntimePrimitive> Primitives;
+		TArray<FString> Materials;
+
+		for (int32 PrimitiveIndex = 0; PrimitiveIndex < NumPrimitives; PrimitiveIndex++)
+		{
+			FglTFRuntimePrimitive Primitive;
+			FString PrimitiveMaterial;
+			Ar << Primitive.MaterialName;
+			Ar << PrimitiveMaterial;
+
+			if (!ReadVectors<FVector, 3>(Ar, Primitive.Positions) || !ReadVectors<FVector, 3>(Ar, Primitive.Normals) || !ReadVectors<FVector4, 4>(Ar, Primitive.Colors) || !ReadVectors<FVector4, 4>(Ar, Primitive.Tangents))
+			{
+				return false;
+			}
+
+			int32 NumUVChannels = 0;
+			Ar << NumUVChannels;
+			if (Ar.IsError() || NumUVChannels < 0 || NumUVChannels > MAX_TEXCOORDS)
+			{
+				return false;
+			}
+
+			Primitive.UVs.AddDefaulted(NumUVChannels);
+			for (TArray<FVector2D>& UVChannel : Primitive.UVs)
+			{
+				if (!ReadVectors<FVector2D, 2>(Ar, UVChannel))
+				{
+					return false;
+				}
+			}
+
+			if (!ReadIndices(Ar, Primitive.Indices))
+			{
+				return false;
+			}
+
+			// stale, truncated or edited files must never hand out of range indices to the mesh build
+			const int32 NumVertices = Primitive.Positions.Num();
+			auto IsValidAttribute = [NumVertices](const int32 NumElements)
+				{
+					return NumElements == 0 || NumElements == NumVertices;
+				};
+
+			if (!IsValidAttribute(Primitive.Normals.Num()) || !IsValidAttribute(Primitive.Colors.Num()) || !IsValidAttribute(Primitive.Tangents.Num()) || Primitive.Indices.Num() % 3 != 0)
+			{
+				return false;
+			}
+
+			for (const TArray<FVector2D>& UVChannel : Primitive.UVs)
+			{
+				if (!IsValidAttribute(UVChannel.Num()))
+				{
+					return false;
+				}
+			}
+
+			for (const uint32 Index : Primitive.Indices)
+			{
+				if (Index >= static_cast<uint32>(NumVertices))
+				{
+					return false;
+				}
+			}
+
+			Primitives.Add(MoveTemp(Primitive));
+			Materials.Add(MoveTemp(PrimitiveMaterial));
+		}
+
+		if (Ar.IsError())
+		{
+			return false;
+		}
+
+		RuntimeLOD.Primitives = MoveTemp(Primitives);
+		PrimitivesMaterials = MoveTemp(Materials);
+		return true;
+	}
+}
@@ -0,0 +1,20 @@
+// Copyright 2023, Roberto De Ioris.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "glTFRuntimeParser.h"
+
+namespace glTFRuntimeOBJ
+{
+	/*
+	 * Binary cache of fully built OBJ objects.
+	 * PrimitivesMaterials contains the usemtl name of each primitive (empty for the default material),
+	 * MaterialLibraries the mtllib filenames required for rebuilding the materials.
+	 */
+	bool SaveRuntimeLODToDiskCache(const FString& Filename, const FglTFRuntimeMeshLOD& RuntimeLOD, const TArray<FString>& PrimitivesMaterials, const TArray<FString>& MaterialLibraries);
+
+	// the file is memory-mapped and its sections are converted (float to the engine vector types) into the primitive arrays;
+	// files with inconsistent attributes counts or out of range indices are rejected
+	bool LoadRuntimeLODFromDiskCache(const FString& Filename, FglTFRuntimeMeshLOD& RuntimeLOD, TArray<FString>& PrimitivesMaterials, TArray<FString>& MaterialLibraries);
+}
@@ -3,6 +3,21 @@
 
 #include "glTFRuntimeOBJFunctionLibrary.h"
 #include "CompGeom/PolygonTriangulation.h"
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "glTFRuntimeFunctionLibrary.h"
+#include "glTFRuntimeOBJDiskCache.h"
+#include "glTFRuntimeOBJGzip.h"
+#include "glTFRuntimeOBJSimplifier.h"
+#include "glTFRuntimeOBJTextureCache.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "JsonObjectConverter.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Runtime/Launch/Resources/Version.h"
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 2
 #include "MaterialDomain.h"
@@ -11,709 +26,3380 @@
 #endif
 
 
+struct FglTFRuntimeOBJLine
+{
+	int64 Offset;
+	int32 Length;
+};
+
+using FglTFRuntimeOBJTokens = TArray<FAnsiStringView, TInlineAllocator<16>>;
+
+/*
+ * Lines are stored as (offset, length) spans into the raw UTF-8 blob and are
+ * split into tokens only when visited, so no per-token allocation is needed.
+ */
+struct FglTFRuntimeOBJLines
+{
+	// only used when the blob is not owned by the parser (archives, material files)
+	TArray64<uint8> OwnedBlob;
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+	TArray<FglTFRuntimeOBJLine> Lines;
+
+	int32 Num() const
+	{
+		return Lines.Num();
+	}
+
+	void Tokenize(const int32 LineIndex, FglTFRuntimeOBJTokens& Tokens) const
+	{
+		Tokenize(Data, Lines[LineIndex], Tokens);
+	}
+
+	static void Tokenize(const uint8* Data, const FglTFRuntimeOBJLine& Line, FglTFRuntimeOBJTokens& Tokens)
+	{
+		Tokens.Reset();
+
+		const ANSICHAR* Chars = reinterpret_cast<const ANSICHAR*>(Data + Line.Offset);
+
+		int32 TokenStart = -1;
+		for (int32 Index = 0; Index < Line.Length; Index++)
+		{
+			const ANSICHAR Char = Chars[Index];
+			if (Char == ' ' || Char == '\t')
+			{
+				if (TokenStart >= 0)
+				{
+					Tokens.Add(FAnsiStringView(Chars + TokenStart, Index - TokenStart));
+					TokenStart = -1;
+				}
+			}
+			else if (TokenStart < 0)
+			{
+				TokenStart = Index;
+			}
+		}
+
+		if (TokenStart >= 0)
+		{
+			Tokens.Add(FAnsiStringView(Chars + TokenStart, Line.Length - TokenStart));
+		}
+	}
+};
+
+struct FglTFRuntimeOBJObjectRange
+{
+	// lines [FirstLine, LastLine) describing the object
+	int32 FirstLine = 0;
+	int32 LastLine = 0;
+	// number of v/vt/vn lines preceding FirstLine (required for relative indices)
+	int32 VertexBase = 0;
+	int32 UVBase = 0;
+	int32 NormalBase = 0;
+	// number of v/vt/vn lines preceding the archive entry of the object (positive indices are relative to the entry)
+	int32 EntryVertexBase = 0;
+	int32 EntryUVBase = 0;
+	int32 EntryNormalBase = 0;
+};
+
+// an .obj file of an archive, all of the entries are concatenated in the geometry blob
+struct FglTFRuntimeOBJEntry
+{
+	FString Name;
+	int64 Offset = 0;
+	int64 Size = 0;
+};
+
+struct FglTFRuntimeOBJVertexKey
+{
+	uint32 Vertex = MAX_uint32;
+	uint32 UV = MAX_uint32;
+	uint32 Normal = MAX_uint32;
+	// only used by generated normals: smoothing group, or the triangle for flat shading
+	uint32 SmoothingGroup = 0;
+	uint32 Triangle = MAX_uint32;
+
+	bool operator==(const FglTFRuntimeOBJVertexKey& Other) const
+	{
+		return Vertex == Other.Vertex && UV == Other.UV && Normal == Other.Normal && SmoothingGroup == Other.SmoothingGroup && Triangle == Other.Triangle;
+	}
+
+	friend uint32 GetTypeHash(const FglTFRuntimeOBJVertexKey& Key)
+	{
+		return HashCombine(HashCombine(HashCombine(Key.Vertex, Key.UV), Key.Normal), HashCombine(Key.SmoothingGroup, Key.Triangle));
+	}
+};
+
+/*
+ * Float32 structure of arrays attribute storage: half the memory of FVector/FVector2D on UE5.
+ * Values are narrowed only once, after the parser transform has been applied in double precision.
+ */
+template<int32 InNumComponents>
+struct TglTFRuntimeOBJAttributePool
+{
+	static constexpr int32 NumComponents = InNumComponents;
+
+	TArray<float> Components[NumComponents];
+
+	int32 Num() const
+	{
+		return Components[0].Num();
+	}
+
+	bool IsValidIndex(const int32 Index) const
+	{
+		return Components[0].IsValidIndex(Index);
+	}
+};
+
+struct FglTFRuntimeOBJVectorPool : TglTFRuntimeOBJAttributePool<3>
+{
+	void Add(const double X, const double Y, const double Z)
+	{
+		Components[0].Add(static_cast<float>(X));
+		Components[1].Add(static_cast<float>(Y));
+		Components[2].Add(static_cast<float>(Z));
+	}
+
+	FVector operator[](const int32 Index) const
+	{
+		return FVector(Components[0][Index], Components[1][Index], Components[2][Index]);
+	}
+};
+
+struct FglTFRuntimeOBJColorPool : TglTFRuntimeOBJAttributePool<4>
+{
+	void Add(const double R, const double G, const double B, const double A)
+	{
+		Components[0].Add(static_cast<float>(R));
+		Components[1].Add(static_cast<float>(G));
+		Components[2].Add(static_cast<float>(B));
+		Components[3].Add(static_cast<float>(A));
+	}
+
+	FVector4 operator[](const int32 Index) const
+	{
+		return FVector4(Components[0][Index], Components[1][Index], Components[2][Index], Components[3][Index]);
+	}
+};
+
+struct FglTFRuntimeOBJUVPool : TglTFRuntimeOBJAttributePool<2>
+{
+	void Add(const double U, const double V)
+	{
+		Components[0].Add(static_cast<float>(U));
+		Components[1].Add(static_cast<float>(V));
+	}
+
+	FVector2D operator[](const int32 Index) const
+	{
+		return FVector2D(Components[0][Index], Components[1][Index]);
+	}
+};
+
+/*
+ * The parser transform, applied in double precision to every parsed v/vn.
+ * It is probed as an affine matrix, if the probe does not describe it each element goes through the parser.
+ */
+struct FglTFRuntimeOBJGeometryTransform
+{
+	FglTFRuntimeParser* Parser = nullptr;
+	bool bAffine = true;
+	// 3 axis rows and the origin row
+	double Positions[4][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 0, 0, 0 } };
+	double Vectors[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+	// identity
+	FglTFRuntimeOBJGeometryTransform() = default;
+
+	explicit FglTFRuntimeOBJGeometryTransform(FglTFRuntimeParser& InParser) : Parser(&InParser)
+	{
+		bAffine = Probe([this](const FVector& Vector) { return Parser->TransformPosition(Vector); }, true, Positions) &&
+			Probe([this](const FVector& Vector) { return Parser->TransformVector(Vector); }, false, Vectors);
+	}
+
+	void TransformPosition(double& X, double& Y, double& Z) const
+	{
+		if (!bAffine)
+		{
+			Assign(Parser->TransformPosition(FVector(X, Y, Z)), X, Y, Z);
+			return;
+		}
+		Apply(Positions, X, Y, Z);
+		X += Positions[3][0];
+		Y += Positions[3][1];
+		Z += Positions[3][2];
+	}
+
+	void TransformVector(double& X, double& Y, double& Z) const
+	{
+		if (!bAffine)
+		{
+			Assign(Parser->TransformVector(FVector(X, Y, Z)), X, Y, Z);
+			return;
+		}
+		Apply(Vectors, X, Y, Z);
+	}
+
+private:
+	static void Apply(const double Matrix[][3], double& X, double& Y, double& Z)
+	{
+		const double SourceX = X;
+		const double SourceY = Y;
+		const double SourceZ = Z;
+		X = SourceX * Matrix[0][0] + SourceY * Matrix[1][0] + SourceZ * Matrix[2][0];
+		Y = SourceX * Matrix[0][1] + SourceY * Matrix[1][1] + SourceZ * Matrix[2][1];
+		Z = SourceX * Matrix[0][2] + SourceY * Matrix[1][2] + SourceZ * Matrix[2][2];
+	}
+
+	static void Assign(const FVector& Vector, double& X, double& Y, double& Z)
+	{
+		X = Vector.X;
+		Y = Vector.Y;
+		Z = Vector.Z;
+	}
+
+	static bool Probe(TFunctionRef<FVector(const FVector&)> Transform, const bool bTranslate, double Matrix[][3])
+	{
+		const FVector Origin = bTranslate ? Transform(FVector::ZeroVector) : FVector::ZeroVector;
+		const FVector Axes[3] = { Transform(FVector(1, 0, 0)) - Origin, Transform(FVector(0, 1, 0)) - Origin, Transform(FVector(0, 0, 1)) - Origin };
+
+		const FVector ProbeVector = FVector(0.5, -2, 3);
+		const FVector Expected = Origin + Axes[0] * ProbeVector.X + Axes[1] * ProbeVector.Y + Axes[2] * ProbeVector.Z;
+		if (!Transform(ProbeVector).Equals(Expected, KINDA_SMALL_NUMBER * FMath::Max<double>(1.0, Expected.GetAbsMax())))
+		{
+			return false;
+		}
+
+		for (int32 Row = 0; Row < 3; Row++)
+		{
+			Matrix[Row][0] = Axes[Row].X;
+			Matrix[Row][1] = Axes[Row].Y;
+			Matrix[Row][2] = Axes[Row].Z;
+		}
+
+		if (bTranslate)
+		{
+			Matrix[3][0] = Origin.X;
+			Matrix[3][1] = Origin.Y;
+			Matrix[3][2] = Origin.Z;
+		}
+		return true;
+	}
+};
+
+enum class EglTFRuntimeOBJChunkEventType : uint8
+{
+	Face,
+	Object,
+	MaterialLibrary,
+	MaterialUse
+};
+
+// lines relevant for the object index, collected by each chunk in file order
+struct FglTFRuntimeOBJChunkEvent
+{
+	EglTFRuntimeOBJChunkEventType Type;
+	int32 LineIndex;
+	int32 NumVertices;
+	int32 NumUVs;
+	int32 NumNormals;
+};
+
+// a newline-aligned region of the geometry blob parsed by a single worker
+struct FglTFRuntimeOBJChunk
+{
+	int64 Start = 0;
+	int64 End = 0;
+	// archive entry containing the chunk
+	int32 Entry = 0;
+	TArray<FglTFRuntimeOBJLine> Lines;
+	// already transformed
+	FglTFRuntimeOBJVectorPool Vertices;
+	FglTFRuntimeOBJVectorPool Normals;
+	FglTFRuntimeOBJUVPool UVs;
+	// empty if no vertex of the chunk has a color, otherwise parallel to Vertices
+	FglTFRuntimeOBJColorPool Colors;
+	TArray<FglTFRuntimeOBJChunkEvent> Events;
+	bool bValidAttributes = true;
+};
+
+DECLARE_STATS_GROUP(TEXT("glTFRuntimeOBJ"), STATGROUP_glTFRuntimeOBJ, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Parse Geometry"), STAT_glTFRuntimeOBJ_ParseGeometry, STATGROUP_glTFRuntimeOBJ);
+DECLARE_CYCLE_STAT(TEXT("Load Material Libraries"), STAT_glTFRuntimeOBJ_LoadMaterialLibraries, STATGROUP_glTFRuntimeOBJ);
+DECLARE_CYCLE_STAT(TEXT("Build Object"), STAT_glTFRuntimeOBJ_BuildObject, STATGROUP_glTFRuntimeOBJ);
+DECLARE_CYCLE_STAT(TEXT("Fill Material"), STAT_glTFRuntimeOBJ_FillMaterial, STATGROUP_glTFRuntimeOBJ);
+DECLARE_CYCLE_STAT(TEXT("Decode Texture"), STAT_glTFRuntimeOBJ_DecodeTexture, STATGROUP_glTFRuntimeOBJ);
+DECLARE_CYCLE_STAT(TEXT("Build Materials (GameThread)"), STAT_glTFRuntimeOBJ_BuildMaterials, STATGROUP_glTFRuntimeOBJ);
+
+// adds the elapsed seconds to Target (when not null) on scope exit
+struct FglTFRuntimeOBJScopeTimer
+{
+	float* Target;
+	double StartTime;
+
+	FglTFRuntimeOBJScopeTimer(float* InTarget) : Target(InTarget), StartTime(InTarget ? FPlatformTime::Seconds() : 0)
+	{
+	}
+
+	~FglTFRuntimeOBJScopeTimer()
+	{
+		if (Target)
+		{
+			*Target += static_cast<float>(FPlatformTime::Seconds() - StartTime);
+		}
+	}
+};
+
+enum class EglTFRuntimeOBJTextureSlot : uint8
+{
+	BaseColor,
+	Normal,
+	Alpha,
+	Roughness,
+	Metallic,
+	Specular,
+	Glossiness,
+	Num
+};
+
+struct FglTFRuntimeOBJTextureRequest
+{
+	EglTFRuntimeOBJTextureSlot Slot;
+	FString Filename;
+	bool bSRGB;
+};
+
+// a material being filled, its textures are decoded (for all of the pending materials) before being assigned
+struct FglTFRuntimeOBJPendingMaterial
+{
+	FString Name;
+	TSharedRef<FglTFRuntimeMaterial> Material = MakeShared<FglTFRuntimeMaterial>();
+	TArray<FglTFRuntimeOBJTextureRequest> TextureRequests;
+	TOptional<FLinearColor> SpecularFactor;
+	TOptional<double> RoughnessFactor;
+	TOptional<double> MetallicFactor;
+};
+
 struct FglTFRuntimeOBJCacheData : FglTFRuntimePluginCacheData
 {
-	TArray<TArray<FString>> GeometryLines;
-	TArray<TArray<FString>> MaterialLines;
+	FglTFRuntimeOBJLines GeometryLines;
+	FglTFRuntimeOBJLines MaterialLines;
+	// first line (after newmtl) of each material
+	TMap<FString, int32> MaterialFirstLines;
+	// filled materials (including their decoded mips), keyed by material name and materials config
+	TMap<FString, TSharedRef<const FglTFRuntimeMaterial>> Materials;
+	// decoded textures (shared with the other assets), keyed by filename, sRGB and materials config
+	TMap<FString, FglTFRuntimeOBJSharedMips> TexturesMips;
+	// already built material instances, keyed by material name and materials config
+	TMap<FString, TWeakObjectPtr<UMaterialInterface>> BuiltMaterials;
+	// sorted indices of the usemtl lines
+	TArray<int32> MaterialUseLines;
+	TArray<FString> MaterialLibraries;
+	bool bMaterialLibrariesLoaded = false;
 	TArray<FString> ObjectNames;
-	TMap<FString, FglTFRuntimeMeshLOD> Objects;
+	TMap<FString, FglTFRuntimeOBJObjectRange> ObjectRanges;
+	// .obj files of archives (empty for plain OBJ assets)
+	TArray<FglTFRuntimeOBJEntry> Entries;
+	// built objects (and LODs chains), immutable and shared by all of the loads
+	TMap<FString, FglTFRuntimeOBJSharedMeshLODs> Objects;
+
+	/*
+	 * Everything parsed in GetCacheData is immutable once bValid is set and can be
+	 * read without locking. Only the lazily filled caches have their own locks.
+	 */
+	FRWLock ObjectsLock;
+	// guards Materials, TexturesMips and BuiltMaterials
+	FCriticalSection MaterialsLock;
+
+	// global attribute pools (already transformed)
+	FglTFRuntimeOBJVectorPool Vertices;
+	FglTFRuntimeOBJVectorPool Normals;
+	FglTFRuntimeOBJUVPool UVs;
+	// empty if the file has no vertex colors, otherwise parallel to Vertices
+	FglTFRuntimeOBJColorPool Colors;
+	// the parser transform flips handedness, so face normals must be computed with the reversed cross product
+	bool bMirrored = false;
+	bool bValidAttributes = true;
+
+	bool bSourceResolved = false;
+	// content hash of the geometry blob (for the disk cache)
+	TOptional<uint64> GeometryHash;
+	// "o" lines found by the raw scan (see GetObjectInfos)
+	TOptional<TArray<FglTFRuntimeOBJObjectInfo>> ObjectInfos;
+
+	// geometry mapped from disk (see LoadOBJAssetFromFilenameMapped), the region must be released before the handle
+	FString MappedFilename;
+	TUniquePtr<IMappedFileHandle> MappedFileHandle;
+	TUniquePtr<IMappedFileRegion> MappedFileRegion;
 };
 
 namespace glTFRuntimeOBJ
 {
-	FString GetRemainingString(const TArray<FString>& Line, const int32 Index)
+	bool IsToken(const FAnsiStringView& Token, const ANSICHAR* Keyword)
+	{
+		const int32 KeywordLength = FCStringAnsi::Strlen(Keyword);
+		return Token.Len() == KeywordLength && FCStringAnsi::Strnicmp(Token.GetData(), Keyword, KeywordLength) == 0;
+	}
+
+	FString TokenToString(const ANSICHAR* Start, const int32 Length)
+	{
+		FUTF8ToTCHAR Converter(Start, Length);
+		return FString(Converter.Length(), Converter.Get());
+	}
+
+	FString GetRemainingString(const FglTFRuntimeOBJTokens& Line, const int32 Index)
 	{
-		FString NewString;
 		if (!Line.IsValidIndex(Index))
 		{
-			return NewString;
+			return FString();
+		}
+
+		// the original spacing between tokens is preserved (useful for filenames)
+		const ANSICHAR* Start = Line[Index].GetData();
+		const ANSICHAR* End = Line.Last().GetData() + Line.Last().Len();
+		return TokenToString(Start, static_cast<int32>(End - Start));
+	}
+
+	/*
+	 * Locale-free number parsing working directly on the UTF-8 bytes.
+	 * Floats are computed exactly (Clinger's fast path) when the mantissa fits
+	 * in 53 bits and the decimal exponent is small, otherwise the slower but
+	 * correctly rounded Atod is used.
+	 */
+	bool ParseDouble(const ANSICHAR*& Cursor, const ANSICHAR* End, double& Value)
+	{
+		static const double PowersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+		const ANSICHAR* Start = Cursor;
+		const ANSICHAR* Current = Cursor;
+
+		const bool bNegative = Current < End && *Current == '-';
+		if (Current < End && (*Current == '-' || *Current == '+'))
+		{
+			Current++;
 		}
 
-		for (int32 CurrentIndex = Index; CurrentIndex < Line.Num(); CurrentIndex++)
+		uint64 Mantissa = 0;
+		int32 NumDigits = 0;
+		int32 Exponent = 0;
+		bool bHasDigits = false;
+
+		while (Current < End && static_cast<uint8>(*Current - '0') < 10)
 		{
-			if (CurrentIndex == Index)
+			if (NumDigits < 19)
 			{
-				NewString += Line[CurrentIndex];
+				Mantissa = Mantissa * 10 + (*Current - '0');
+				NumDigits += Mantissa > 0 ? 1 : 0;
 			}
 			else
 			{
-				NewString += " " + Line[CurrentIndex];
+				Exponent++;
 			}
+			bHasDigits = true;
+			Current++;
 		}
-		return NewString;
-	}
-
-	void FillLinesFromBlob(const TArray64<uint8>& Blob, TArray<TArray<FString>>& Lines)
-	{
-		TArray<FString> CurrentLine;
-		TArray<uint8> CurrentString;
 
-		for (int64 Index = 0; Index < Blob.Num(); Index++)
+		if (Current < End && *Current == '.')
 		{
-			const uint8 Char = Blob[Index];
-			if (Char == ' ' || Char == '\t' || Char == '\r' || Char == '\n')
+			Current++;
+			while (Current < End && static_cast<uint8>(*Current - '0') < 10)
 			{
-				if (CurrentString.Num() > 0)
+				if (NumDigits < 19)
 				{
-					CurrentString.Add(0);
-					CurrentLine.Add(UTF8_TO_TCHAR(CurrentString.GetData()));
+					Mantissa = Mantissa * 10 + (*Current - '0');
+					NumDigits += Mantissa > 0 ? 1 : 0;
+					Exponent--;
 				}
-				CurrentString.Empty();
-				if (Char == '\r' || Char == '\n')
+				bHasDigits = true;
+				Current++;
+			}
+		}
+
+		if (!bHasDigits)
+		{
+			return false;
+		}
+
+		if (Current < End && (*Current == 'e' || *Current == 'E'))
+		{
+			const ANSICHAR* ExponentStart = Current++;
+			const bool bNegativeExponent = Current < End && *Current == '-';
+			if (Current < End && (*Current == '-' || *Current == '+'))
+			{
+				Current++;
+			}
+
+			if (Current < End && static_cast<uint8>(*Current - '0') < 10)
+			{
+				int32 ExplicitExponent = 0;
+				while (Current < End && static_cast<uint8>(*Current - '0') < 10)
 				{
-					if (CurrentLine.Num() > 0)
-					{
-						Lines.Add(CurrentLine);
-					}
-					CurrentLine.Empty();
+					ExplicitExponent = FMath::Min(ExplicitExponent * 10 + (*Current - '0'), 100000);
+					Current++;
 				}
+				Exponent += bNegativeExponent ? -ExplicitExponent : ExplicitExponent;
 			}
 			else
 			{
-				CurrentString.Add(Char);
+				// not an exponent, leave it to the caller
+				Current = ExponentStart;
 			}
 		}
 
-		if (CurrentString.Num() > 0)
+		Cursor = Current;
+
+		if (Mantissa <= (1ULL << 53) && Exponent >= -22 && Exponent <= 22)
+		{
+			Value = static_cast<double>(Mantissa);
+			Value = Exponent < 0 ? Value / PowersOf10[-Exponent] : Value * PowersOf10[Exponent];
+			Value = bNegative ? -Value : Value;
+			return true;
+		}
+
+		ANSICHAR Buffer[128];
+		const int32 Length = FMath::Min<int32>(static_cast<int32>(Current - Start), UE_ARRAY_COUNT(Buffer) - 1);
+		FMemory::Memcpy(Buffer, Start, Length);
+		Buffer[Length] = 0;
+		Value = FCStringAnsi::Atod(Buffer);
+		return true;
+	}
+
+	bool ParseInt(const ANSICHAR*& Cursor, const ANSICHAR* End, int32& Value)
+	{
+		const ANSICHAR* Current = Cursor;
+
+		const bool bNegative = Current < End && *Current == '-';
+		if (Current < End && (*Current == '-' || *Current == '+'))
+		{
+			Current++;
+		}
+
+		if (Current >= End || static_cast<uint8>(*Current - '0') >= 10)
+		{
+			return false;
+		}
+
+		int64 Result = 0;
+		while (Current < End && static_cast<uint8>(*Current - '0') < 10)
 		{
-			CurrentString.Add(0);
-			CurrentLine.Add(UTF8_TO_TCHAR(CurrentString.GetData()));
+			Result = FMath::Min<int64>(Result * 10 + (*Current - '0'), MAX_int32);
+			Current++;
 		}
 
-		if (CurrentLine.Num() > 0)
+		Value = static_cast<int32>(bNegative ? -Result : Result);
+		Cursor = Current;
+		return true;
+	}
+
+	double TokenToDouble(const FAnsiStringView& Token)
+	{
+		const ANSICHAR* Cursor = Token.GetData();
+		double Value = 0;
+		if (ParseDouble(Cursor, Token.GetData() + Token.Len(), Value))
 		{
-			Lines.Add(CurrentLine);
+			return Value;
 		}
+
+		// inf, nan and other oddities
+		ANSICHAR Buffer[128];
+		const int32 Length = FMath::Min<int32>(Token.Len(), UE_ARRAY_COUNT(Buffer) - 1);
+		FMemory::Memcpy(Buffer, Token.GetData(), Length);
+		Buffer[Length] = 0;
+		return FCStringAnsi::Atod(Buffer);
 	}
 
-	TSharedPtr<FglTFRuntimeOBJCacheData> GetCacheData(UglTFRuntimeAsset* Asset)
+	int32 TokenToInt(const FAnsiStringView& Token)
 	{
-		if (Asset->GetParser()->PluginsCacheData.Contains("OBJ"))
+		const ANSICHAR* Cursor = Token.GetData();
+		int32 Value = 0;
+		ParseInt(Cursor, Token.GetData() + Token.Len(), Value);
+		return Value;
+	}
+
+	/*
+	 * Parses a "v", "v/vt", "v//vn" or "v/vt/vn" face corner.
+	 * Missing or empty components leave the related flag to false.
+	 */
+	void ParseFaceVertex(const FAnsiStringView& Token, int32 (&Values)[3], bool (&bHasValues)[3])
+	{
+		const ANSICHAR* Cursor = Token.GetData();
+		const ANSICHAR* End = Cursor + Token.Len();
+
+		for (int32 Part = 0; Part < 3; Part++)
 		{
-			if (Asset->GetParser()->PluginsCacheData["OBJ"] && Asset->GetParser()->PluginsCacheData["OBJ"]->bValid)
+			Values[Part] = 0;
+			bHasValues[Part] = ParseInt(Cursor, End, Values[Part]);
+
+			// skip garbage up to the next separator
+			while (Cursor < End && *Cursor != '/')
 			{
-				return StaticCastSharedPtr<FglTFRuntimeOBJCacheData>(Asset->GetParser()->PluginsCacheData["OBJ"]);
+				Cursor++;
 			}
-		}
 
-		if (!Asset->GetParser()->PluginsCacheData.Contains("OBJ"))
-		{
-			Asset->GetParser()->PluginsCacheData.Add("OBJ", MakeShared<FglTFRuntimeOBJCacheData>());
+			if (Cursor >= End)
+			{
+				for (int32 MissingPart = Part + 1; MissingPart < 3; MissingPart++)
+				{
+					Values[MissingPart] = 0;
+					bHasValues[MissingPart] = false;
+				}
+				break;
+			}
+			Cursor++;
 		}
+	}
 
-		TArray64<uint8> ArchiveBlob;
+	void FillLinesFromBlob(const uint8* Data, const int64 Start, const int64 End, TArray<FglTFRuntimeOBJLine>& Lines)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_FillLinesFromBlob);
 
-		const TArray64<uint8>* Blob = nullptr;
+		int64 LineStart = -1;
+		int64 LineEnd = -1;
 
-		if (Asset->IsArchive())
+		for (int64 Index = Start; Index < End; Index++)
 		{
-			for (const FString& Name : Asset->GetArchiveItems())
+			const uint8 Char = Data[Index];
+			if (Char == '\r' || Char == '\n')
 			{
-				if (Name.EndsWith(".obj"))
+				if (LineStart >= 0)
 				{
-					if (!Asset->GetParser()->GetBlobByName(Name, ArchiveBlob))
-					{
-						return nullptr;
-					}
-
-					Blob = &ArchiveBlob;
-					break;
+					Lines.Add({ LineStart, static_cast<int32>(LineEnd - LineStart) });
+				}
+				LineStart = -1;
+			}
+			else if (Char != ' ' && Char != '\t')
+			{
+				if (LineStart < 0)
+				{
+					LineStart = Index;
 				}
+				LineEnd = Index + 1;
 			}
 		}
-		else
+
+		if (LineStart >= 0)
 		{
-			Blob = &(Asset->GetParser()->GetBlob());
+			Lines.Add({ LineStart, static_cast<int32>(LineEnd - LineStart) });
 		}
+	}
+
+	void FillLinesFromBlob(FglTFRuntimeOBJLines& Lines)
+	{
+		FillLinesFromBlob(Lines.Data, 0, Lines.Size, Lines.Lines);
+	}
+
+	void SplitBlobInChunks(const uint8* Data, const int64 Size, TArray<FglTFRuntimeOBJChunk>& Chunks)
+	{
+		constexpr int64 MinChunkSize = 1024 * 1024;
+		const int64 MaxChunks = FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads() * 4, 1);
+		const int64 NumChunks = FMath::Clamp<int64>(Size / MinChunkSize, 1, MaxChunks);
 
-		if (!Blob)
+		int64 ChunkStart = 0;
+		for (int64 ChunkIndex = 0; ChunkIndex < NumChunks && ChunkStart < Size; ChunkIndex++)
 		{
-			return nullptr;
+			int64 ChunkEnd = ChunkIndex == NumChunks - 1 ? Size : FMath::Max(ChunkStart, (Size * (ChunkIndex + 1)) / NumChunks);
+			// move the end after the next line terminator
+			while (ChunkEnd < Size && Data[ChunkEnd] != '\n' && Data[ChunkEnd] != '\r')
+			{
+				ChunkEnd++;
+			}
+			ChunkEnd = FMath::Min(ChunkEnd + 1, Size);
+
+			FglTFRuntimeOBJChunk& Chunk = Chunks.AddDefaulted_GetRef();
+			Chunk.Start = ChunkStart;
+			Chunk.End = ChunkEnd;
+			ChunkStart = ChunkEnd;
 		}
+	}
 
-		TSharedPtr<FglTFRuntimeOBJCacheData> RuntimeOBJCacheData = StaticCastSharedPtr<FglTFRuntimeOBJCacheData>(Asset->GetParser()->PluginsCacheData["OBJ"]);
+	void ParseGeometryChunk(const uint8* Data, FglTFRuntimeOBJChunk& Chunk, const FglTFRuntimeOBJGeometryTransform& Transform)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_ParseGeometryChunk);
+
+		FillLinesFromBlob(Data, Chunk.Start, Chunk.End, Chunk.Lines);
 
-		FillLinesFromBlob(*Blob, RuntimeOBJCacheData->GeometryLines);
+		auto AddEvent = [&Chunk](const EglTFRuntimeOBJChunkEventType Type, const int32 LineIndex)
+			{
+				Chunk.Events.Add({ Type, LineIndex, Chunk.Vertices.Num(), Chunk.UVs.Num(), Chunk.Normals.Num() });
+			};
 
-		// build materials
-		for (int32 LineIndex = 0; LineIndex < RuntimeOBJCacheData->GeometryLines.Num(); LineIndex++)
+		FglTFRuntimeOBJTokens Line;
+		for (int32 LineIndex = 0; LineIndex < Chunk.Lines.Num(); LineIndex++)
 		{
-			const TArray<FString>& Line = RuntimeOBJCacheData->GeometryLines[LineIndex];
+			FglTFRuntimeOBJLines::Tokenize(Data, Chunk.Lines[LineIndex], Line);
+
+			// vertex
+			if (IsToken(Line[0], "v"))
+			{
+				if (Line.Num() < 4)
+				{
+					Chunk.bValidAttributes = false;
+					continue;
+				}
+
+				double X = TokenToDouble(Line[1]);
+				double Y = TokenToDouble(Line[2]);
+				double Z = TokenToDouble(Line[3]);
+				Transform.TransformPosition(X, Y, Z);
+				Chunk.Vertices.Add(X, Y, Z);
+
+				// "v x y z r g b [a]" (a 5 tokens line is "v x y z w", w is ignored)
+				if (Line.Num() >= 7)
+				{
+					// vertices without color before the first colored one default to white
+					while (Chunk.Colors.Num() < Chunk.Vertices.Num() - 1)
+					{
+						Chunk.Colors.Add(1, 1, 1, 1);
+					}
+					Chunk.Colors.Add(TokenToDouble(Line[4]), TokenToDouble(Line[5]), TokenToDouble(Line[6]), Line.Num() >= 8 ? TokenToDouble(Line[7]) : 1);
+				}
+				else if (Chunk.Colors.Num() > 0)
+				{
+					Chunk.Colors.Add(1, 1, 1, 1);
+				}
+				continue;
+			}
+
+			// uv
+			if (IsToken(Line[0], "vt"))
+			{
+				if (Line.Num() < 3)
+				{
+					Chunk.bValidAttributes = false;
+					continue;
+				}
+
+				Chunk.UVs.Add(TokenToDouble(Line[1]), 1 - TokenToDouble(Line[2]));
+				continue;
+			}
+
+			// normal
+			if (IsToken(Line[0], "vn"))
+			{
+				if (Line.Num() < 4)
+				{
+					Chunk.bValidAttributes = false;
+					continue;
+				}
+
+				double X = TokenToDouble(Line[1]);
+				double Y = TokenToDouble(Line[2]);
+				double Z = TokenToDouble(Line[3]);
+				Transform.TransformVector(X, Y, Z);
+				Chunk.Normals.Add(X, Y, Z);
+				continue;
+			}
+
+			// only the first face of a run is relevant for the object index
+			if (IsToken(Line[0], "f"))
+			{
+				if (Chunk.Events.Num() == 0 || Chunk.Events.Last().Type != EglTFRuntimeOBJChunkEventType::Face)
+				{
+					AddEvent(EglTFRuntimeOBJChunkEventType::Face, LineIndex);
+				}
+				continue;
+			}
+
+			if (IsToken(Line[0], "o"))
+			{
+				AddEvent(EglTFRuntimeOBJChunkEventType::Object, LineIndex);
+				continue;
+			}
+
+			if (IsToken(Line[0], "mtllib"))
+			{
+				AddEvent(EglTFRuntimeOBJChunkEventType::MaterialLibrary, LineIndex);
+				continue;
+			}
+
+			if (IsToken(Line[0], "usemtl"))
+			{
+				AddEvent(EglTFRuntimeOBJChunkEventType::MaterialUse, LineIndex);
+				continue;
+			}
+		}
+	}
+
+	template<typename T>
+	void MergeChunkArrays(TArray<T>& Destination, TArray<FglTFRuntimeOBJChunk>& Chunks, TArray<T> FglTFRuntimeOBJChunk::* Member)
+	{
+		TArray<int32> Offsets;
+		int32 Total = 0;
+		for (FglTFRuntimeOBJChunk& Chunk : Chunks)
+		{
+			Offsets.Add(Total);
+			Total += (Chunk.*Member).Num();
+		}
+
+		Destination.SetNumUninitialized(Total);
+
+		ParallelFor(Chunks.Num(), [&](const int32 ChunkIndex)
+			{
+				TArray<T>& Source = Chunks[ChunkIndex].*Member;
+				FMemory::Memcpy(Destination.GetData() + Offsets[ChunkIndex], Source.GetData(), Source.Num() * sizeof(T));
+				Source.Empty();
+			});
+	}
+
+	template<typename PoolType>
+	void MergeChunkPools(PoolType& Destination, TArray<FglTFRuntimeOBJChunk>& Chunks, PoolType FglTFRuntimeOBJChunk::* Member)
+	{
+		TArray<int32> Offsets;
+		int32 Total = 0;
+		for (FglTFRuntimeOBJChunk& Chunk : Chunks)
+		{
+			Offsets.Add(Total);
+			Total += (Chunk.*Member).Num();
+		}
+
+		for (int32 Component = 0; Component < PoolType::NumComponents; Component++)
+		{
+			Destination.Components[Component].SetNumUninitialized(Total);
+		}
+
+		ParallelFor(Chunks.Num(), [&](const int32 ChunkIndex)
+			{
+				PoolType& Source = Chunks[ChunkIndex].*Member;
+				for (int32 Component = 0; Component < PoolType::NumComponents; Component++)
+				{
+					FMemory::Memcpy(Destination.Components[Component].GetData() + Offsets[ChunkIndex], Source.Components[Component].GetData(), Source.Num() * sizeof(float));
+				}
+				Source = PoolType();
+			});
+	}
+
+	// colors are only stored by the chunks having them, so fill the others with white
+	void MergeChunkColors(FglTFRuntimeOBJColorPool& Destination, TArray<FglTFRuntimeOBJChunk>& Chunks)
+	{
+		if (!Chunks.ContainsByPredicate([](const FglTFRuntimeOBJChunk& Chunk) { return Chunk.Colors.Num() > 0; }))
+		{
+			return;
+		}
+
+		TArray<int32> Offsets;
+		int32 Total = 0;
+		for (FglTFRuntimeOBJChunk& Chunk : Chunks)
+		{
+			Offsets.Add(Total);
+			Total += Chunk.Vertices.Num();
+		}
+
+		for (int32 Component = 0; Component < FglTFRuntimeOBJColorPool::NumComponents; Component++)
+		{
+			Destination.Components[Component].SetNumUninitialized(Total);
+		}
+
+		ParallelFor(Chunks.Num(), [&](const int32 ChunkIndex)
+			{
+				FglTFRuntimeOBJChunk& Chunk = Chunks[ChunkIndex];
+				const int32 NumColors = Chunk.Colors.Num();
+				for (int32 Component = 0; Component < FglTFRuntimeOBJColorPool::NumComponents; Component++)
+				{
+					float* Colors = Destination.Components[Component].GetData() + Offsets[ChunkIndex];
+					if (NumColors > 0)
+					{
+						FMemory::Memcpy(Colors, Chunk.Colors.Components[Component].GetData(), NumColors * sizeof(float));
+					}
+					for (int32 Index = NumColors; Index < Chunk.Vertices.Num(); Index++)
+					{
+						Colors[Index] = 1;
+					}
+				}
+				Chunk.Colors = FglTFRuntimeOBJColorPool();
+			});
+	}
+
+	void ParseChunks(const uint8* Data, const int64 Size, TArray<FglTFRuntimeOBJChunk>& Chunks, const FglTFRuntimeOBJGeometryTransform& Transform)
+	{
+		SplitBlobInChunks(Data, Size, Chunks);
+
+		ParallelFor(Chunks.Num(), [&](const int32 ChunkIndex)
+			{
+				ParseGeometryChunk(Data, Chunks[ChunkIndex], Transform);
+			});
+	}
+
+	// a block of inflated lines, parsed by whoever claims it first (the thread pool or the inflating thread)
+	struct FglTFRuntimeOBJInflatedBlock
+	{
+		FglTFRuntimeOBJChunk Chunk;
+		FThreadSafeCounter Claimed;
+		TFuture<void> Future;
+
+		bool TryClaim()
+		{
+			return Claimed.Set(1) == 0;
+		}
+	};
+
+	/*
+	 * Inflates gzip data into Blob.
+	 * When Chunks is not null, every newline-aligned block is parsed in the thread pool as soon as it is inflated,
+	 * with a bounded number of blocks in flight (the inflating thread parses the oldest block by itself
+	 * when the pool has not started it yet, so it never waits for queued work).
+	 */
+	bool InflateBlob(const uint8* Data, const int64 Size, TArray64<uint8>& Blob, TArray<FglTFRuntimeOBJChunk>* Chunks = nullptr, const FglTFRuntimeOBJGeometryTransform& Transform = FglTFRuntimeOBJGeometryTransform())
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_InflateBlob);
+
+		FglTFRuntimeOBJGzipStream GzipStream(Data, Size);
+		if (!GzipStream.IsValid())
+		{
+			return false;
+		}
+
+		constexpr int64 BlockSize = 4 * 1024 * 1024;
+		const int32 MaxBlocksInFlight = FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads() * 2, 2);
+
+		// the trailer size comes from the file, so it is trusted only up to a plausible compression ratio (the blob grows beyond it);
+		// the extra byte allows detecting the end of the stream without growing the blob
+		constexpr int64 MaxSizeHintRatio = 16;
+		Blob.SetNumUninitialized(FMath::Clamp(GzipStream.GetSizeHint(), Size, Size * MaxSizeHintRatio) + 1);
+
+		TArray<TSharedRef<FglTFRuntimeOBJInflatedBlock, ESPMode::ThreadSafe>> Blocks;
+		int32 NumCompletedBlocks = 0;
+		int64 NumInflated = 0;
+		int64 NumScheduled = 0;
+
+		auto CompleteBlocks = [&](const int32 MaxPendingBlocks)
+			{
+				while (Blocks.Num() - NumCompletedBlocks > MaxPendingBlocks)
+				{
+					FglTFRuntimeOBJInflatedBlock& Block = *Blocks[NumCompletedBlocks++];
+					if (Block.TryClaim())
+					{
+						ParseGeometryChunk(Blob.GetData(), Block.Chunk, Transform);
+					}
+					else
+					{
+						Block.Future.Wait();
+					}
+				}
+			};
+
+		auto ScheduleBlock = [&](const bool bLastBlock)
+			{
+				int64 End = NumInflated;
+				if (!bLastBlock)
+				{
+					// stop after the last line terminator
+					while (End > NumScheduled && Blob[End - 1] != '\n' && Blob[End - 1] != '\r')
+					{
+						End--;
+					}
+				}
+
+				if (End <= NumScheduled)
+				{
+					return;
+				}
+
+				CompleteBlocks(MaxBlocksInFlight - 1);
+
+				TSharedRef<FglTFRuntimeOBJInflatedBlock, ESPMode::ThreadSafe> Block = MakeShared<FglTFRuntimeOBJInflatedBlock, ESPMode::ThreadSafe>();
+				Block->Chunk.Start = NumScheduled;
+				Block->Chunk.End = End;
+				NumScheduled = End;
+
+				// every block is completed before returning, so the transform outlives them
+				const uint8* BlobData = Blob.GetData();
+				const FglTFRuntimeOBJGeometryTransform* BlockTransform = &Transform;
+				Block->Future = Async(EAsyncExecution::ThreadPool, [Block, BlobData, BlockTransform]()
+					{
+						if (Block->TryClaim())
+						{
+							ParseGeometryChunk(BlobData, Block->Chunk, *BlockTransform);
+						}
+					});
+				Blocks.Add(Block);
+			};
+
+		while (!GzipStream.IsFinished())
+		{
+			if (NumInflated >= Blob.Num())
+			{
+				// blocks in flight reference the blob memory
+				CompleteBlocks(0);
+				Blob.SetNumUninitialized(Blob.Num() + FMath::Max(Blob.Num() / 2, BlockSize));
+			}
+
+			const int64 NumRead = GzipStream.Read(Blob.GetData() + NumInflated, FMath::Min(BlockSize, Blob.Num() - NumInflated));
+			if (NumRead < 0)
+			{
+				CompleteBlocks(0);
+				return false;
+			}
+			NumInflated += NumRead;
+
+			if (Chunks && NumInflated - NumScheduled >= BlockSize)
+			{
+				ScheduleBlock(false);
+			}
+		}
+
+		if (Chunks)
+		{
+			ScheduleBlock(true);
+		}
+
+		CompleteBlocks(0);
+		Blob.SetNum(NumInflated);
+
+		if (Chunks)
+		{
+			Chunks->Empty(Blocks.Num());
+			for (TSharedRef<FglTFRuntimeOBJInflatedBlock, ESPMode::ThreadSafe>& Block : Blocks)
+			{
+				Chunks->Add(MoveTemp(Block->Chunk));
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	 * Sets the geometry blob of the cache data.
+	 * Every .obj entry of archives is extracted (one at a time) on its own worker and, when EntriesChunks is not null,
+	 * inflated and parsed on the same worker right after the extraction (chunks offsets are relative to the entry),
+	 * so extraction of the entries overlaps with parsing of the others.
+	 * Gzip sources are inflated in the owned blob (and parsed while inflating when EntriesChunks is not null,
+	 * object names scans and disk cache lookups only inflate). The inflated text stays resident with the cache data.
+	 */
+	bool ResolveGeometrySource(UglTFRuntimeAsset* Asset, FglTFRuntimeOBJCacheData& RuntimeOBJCacheData, TArray<TArray<FglTFRuntimeOBJChunk>>* EntriesChunks = nullptr)
+	{
+		FglTFRuntimeOBJLines& GeometryLines = RuntimeOBJCacheData.GeometryLines;
+		const FglTFRuntimeOBJGeometryTransform Transform(*Asset->GetParser());
+
+		auto InflateSource = [&](const uint8* Data, const int64 Size)
+			{
+				if (EntriesChunks)
+				{
+					EntriesChunks->Empty();
+					EntriesChunks->AddDefaulted();
+				}
+
+				if (!InflateBlob(Data, Size, GeometryLines.OwnedBlob, EntriesChunks ? &(*EntriesChunks)[0] : nullptr, Transform))
+				{
+					return false;
+				}
+
+				GeometryLines.Data = GeometryLines.OwnedBlob.GetData();
+				GeometryLines.Size = GeometryLines.OwnedBlob.Num();
+				return true;
+			};
+
+		if (RuntimeOBJCacheData.MappedFileRegion)
+		{
+			const uint8* MappedData = RuntimeOBJCacheData.MappedFileRegion->GetMappedPtr();
+			const int64 MappedSize = RuntimeOBJCacheData.MappedFileRegion->GetMappedSize();
+			if (FglTFRuntimeOBJGzipStream::IsGzip(MappedData, MappedSize))
+			{
+				if (!InflateSource(MappedData, MappedSize))
+				{
+					return false;
+				}
+
+				// the compressed file is not needed anymore
+				RuntimeOBJCacheData.MappedFileRegion.Reset();
+				RuntimeOBJCacheData.MappedFileHandle.Reset();
+			}
+			else
+			{
+				GeometryLines.Data = MappedData;
+				GeometryLines.Size = MappedSize;
+			}
+		}
+		else if (Asset->IsArchive())
+		{
+			TArray<FString> EntryNames;
+			for (const FString& Name : Asset->GetArchiveItems())
+			{
+				if (Name.EndsWith(".obj") || Name.EndsWith(".obj.gz"))
+				{
+					EntryNames.Add(Name);
+				}
+			}
+
+			if (EntryNames.Num() == 0)
+			{
+				return false;
+			}
+
+			TArray<TArray64<uint8>> EntryBlobs;
+			EntryBlobs.AddDefaulted(EntryNames.Num());
+			if (EntriesChunks)
+			{
+				EntriesChunks->Empty();
+				EntriesChunks->AddDefaulted(EntryNames.Num());
+			}
+
+			FThreadSafeCounter NumFailures;
+			// the parser archive is not documented as thread safe, so only the extraction is serialized
+			// (inflating and parsing of the extracted entries still overlap)
+			FCriticalSection ArchiveLock;
+			ParallelFor(EntryNames.Num(), [&](const int32 EntryIndex)
+				{
+					TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_ExtractEntry);
+					bool bExtracted;
+					{
+						FScopeLock Lock(&ArchiveLock);
+						bExtracted = Asset->GetParser()->GetBlobByName(EntryNames[EntryIndex], EntryBlobs[EntryIndex]);
+					}
+
+					if (!bExtracted)
+					{
+						NumFailures.Increment();
+						return;
+					}
+
+					TArray<FglTFRuntimeOBJChunk>* EntryChunks = EntriesChunks ? &(*EntriesChunks)[EntryIndex] : nullptr;
+
+					if (FglTFRuntimeOBJGzipStream::IsGzip(EntryBlobs[EntryIndex].GetData(), EntryBlobs[EntryIndex].Num()))
+					{
+						const TArray64<uint8> CompressedBlob = MoveTemp(EntryBlobs[EntryIndex]);
+						if (!InflateBlob(CompressedBlob.GetData(), CompressedBlob.Num(), EntryBlobs[EntryIndex], EntryChunks, Transform))
+						{
+							NumFailures.Increment();
+						}
+					}
+					else if (EntryChunks)
+					{
+						ParseChunks(EntryBlobs[EntryIndex].GetData(), EntryBlobs[EntryIndex].Num(), *EntryChunks, Transform);
+					}
+				});
+
+			if (NumFailures.GetValue() > 0)
+			{
+				return false;
+			}
+
+			RuntimeOBJCacheData.Entries.Empty();
+
+			if (EntryBlobs.Num() == 1)
+			{
+				RuntimeOBJCacheData.Entries.Add({ EntryNames[0], 0, EntryBlobs[0].Num() });
+				GeometryLines.OwnedBlob = MoveTemp(EntryBlobs[0]);
+			}
+			else
+			{
+				// each entry is terminated by a newline, so no line can span two entries
+				int64 Offset = 0;
+				for (int32 EntryIndex = 0; EntryIndex < EntryBlobs.Num(); EntryIndex++)
+				{
+					RuntimeOBJCacheData.Entries.Add({ EntryNames[EntryIndex], Offset, EntryBlobs[EntryIndex].Num() + 1 });
+					Offset += EntryBlobs[EntryIndex].Num() + 1;
+				}
+
+				GeometryLines.OwnedBlob.SetNumUninitialized(Offset);
+				ParallelFor(EntryBlobs.Num(), [&](const int32 EntryIndex)
+					{
+						uint8* Destination = GeometryLines.OwnedBlob.GetData() + RuntimeOBJCacheData.Entries[EntryIndex].Offset;
+						FMemory::Memcpy(Destination, EntryBlobs[EntryIndex].GetData(), EntryBlobs[EntryIndex].Num());
+						Destination[EntryBlobs[EntryIndex].Num()] = '\n';
+						EntryBlobs[EntryIndex].Empty();
+					});
+			}
+
+			GeometryLines.Data = GeometryLines.OwnedBlob.GetData();
+			GeometryLines.Size = GeometryLines.OwnedBlob.Num();
+		}
+		else
+		{
+			// the parser blob lives as long as the cache, so just reference it
+			const TArray64<uint8>& Blob = Asset->GetParser()->GetBlob();
+			if (FglTFRuntimeOBJGzipStream::IsGzip(Blob.GetData(), Blob.Num()))
+			{
+				return InflateSource(Blob.GetData(), Blob.Num());
+			}
+
+			GeometryLines.Data = Blob.GetData();
+			GeometryLines.Size = Blob.Num();
+		}
+
+		return GeometryLines.Data != nullptr;
+	}
+
+	void LoadMaterialLibraries(UglTFRuntimeAsset* Asset, FglTFRuntimeOBJCacheData& RuntimeOBJCacheData, const TArray<FString>& MaterialLibraries, FglTFRuntimeOBJLoadStats* Stats)
+	{
+		if (RuntimeOBJCacheData.bMaterialLibrariesLoaded)
+		{
+			return;
+		}
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_LoadMaterialLibraries);
+		SCOPE_CYCLE_COUNTER(STAT_glTFRuntimeOBJ_LoadMaterialLibraries);
+		FglTFRuntimeOBJScopeTimer Timer(Stats ? &Stats->MaterialLibrariesTime : nullptr);
+
+		RuntimeOBJCacheData.MaterialLibraries = MaterialLibraries;
+
+		FglTFRuntimeOBJLines& MaterialLines = RuntimeOBJCacheData.MaterialLines;
+		MaterialLines.OwnedBlob.Empty();
+		MaterialLines.Lines.Empty();
+
+		// compressed libraries can be referenced without their .gz extension
+		auto LoadMaterialBlob = [Asset](const FString& Filename, TArray64<uint8>& Blob)
+			{
+				return Asset->GetParser()->LoadPathToBlob(Filename, Blob) || Asset->GetParser()->LoadPathToBlob(Filename + ".gz", Blob);
+			};
+
+		for (const FString& MaterialFilename : MaterialLibraries)
+		{
+			TArray64<uint8> MaterialBlob;
+			if (!LoadMaterialBlob(MaterialFilename, MaterialBlob))
+			{
+				// fallback to filename.mtl (model.obj.gz uses model.mtl)
+				FString BaseFilename = RuntimeOBJCacheData.MappedFilename.IsEmpty() ? Asset->GetParser()->GetBaseFilename() : FPaths::ChangeExtension(RuntimeOBJCacheData.MappedFilename, "");
+				if (BaseFilename.EndsWith(".obj"))
+				{
+					BaseFilename.LeftChopInline(4);
+				}
+				if (!LoadMaterialBlob(BaseFilename + ".mtl", MaterialBlob))
+				{
+					continue;
+				}
+			}
+
+			if (FglTFRuntimeOBJGzipStream::IsGzip(MaterialBlob.GetData(), MaterialBlob.Num()))
+			{
+				const TArray64<uint8> CompressedBlob = MoveTemp(MaterialBlob);
+				if (!InflateBlob(CompressedBlob.GetData(), CompressedBlob.Num(), MaterialBlob))
+				{
+					continue;
+				}
+			}
+
+			// multiple material libraries are concatenated in a single blob
+			MaterialLines.OwnedBlob.Append(MaterialBlob);
+			MaterialLines.OwnedBlob.Add('\n');
+		}
+
+		MaterialLines.Data = MaterialLines.OwnedBlob.GetData();
+		MaterialLines.Size = MaterialLines.OwnedBlob.Num();
+		FillLinesFromBlob(MaterialLines);
+
+		RuntimeOBJCacheData.MaterialFirstLines.Empty();
+		RuntimeOBJCacheData.Materials.Empty();
+		RuntimeOBJCacheData.TexturesMips.Empty();
+		RuntimeOBJCacheData.BuiltMaterials.Empty();
+
+		FglTFRuntimeOBJTokens Line;
+		for (int32 LineIndex = 0; LineIndex < MaterialLines.Num(); LineIndex++)
+		{
+			MaterialLines.Tokenize(LineIndex, Line);
+			if (IsToken(Line[0], "newmtl"))
+			{
+				const FString MaterialName = GetRemainingString(Line, 1);
+				if (!RuntimeOBJCacheData.MaterialFirstLines.Contains(MaterialName))
+				{
+					RuntimeOBJCacheData.MaterialFirstLines.Add(MaterialName, LineIndex + 1);
+				}
+			}
+		}
+
+		RuntimeOBJCacheData.bMaterialLibrariesLoaded = true;
+	}
+
+	/*
+	 * Returns the OBJ cache data of the asset, building it on the first call.
+	 * When bParseGeometry is false only the geometry source is resolved (used by the disk cache).
+	 * Stats (if any) receive the parsing times when the parsing happens in this call.
+	 */
+	TSharedPtr<FglTFRuntimeOBJCacheData> GetCacheData(UglTFRuntimeAsset* Asset, const bool bParseGeometry = true, FglTFRuntimeOBJLoadStats* Stats = nullptr)
+	{
+		// the lock is only required for initializing the cache data
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		if (!Asset->GetParser()->PluginsCacheData.Contains("OBJ") || !Asset->GetParser()->PluginsCacheData["OBJ"])
+		{
+			Asset->GetParser()->PluginsCacheData.Add("OBJ", MakeShared<FglTFRuntimeOBJCacheData>());
+		}
+
+		TSharedPtr<FglTFRuntimeOBJCacheData> RuntimeOBJCacheData = StaticCastSharedPtr<FglTFRuntimeOBJCacheData>(Asset->GetParser()->PluginsCacheData["OBJ"]);
+		if (RuntimeOBJCacheData->bValid)
+		{
+			return RuntimeOBJCacheData;
+		}
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_ParseGeometry);
+		SCOPE_CYCLE_COUNTER(STAT_glTFRuntimeOBJ_ParseGeometry);
+		// archives entries are parsed while being extracted, so this includes their extraction
+		const double ParseStartTime = FPlatformTime::Seconds();
+
+		// chunks of the archive entries already parsed while resolving the source
+		TArray<TArray<FglTFRuntimeOBJChunk>> EntriesChunks;
+
+		if (!RuntimeOBJCacheData->bSourceResolved)
+		{
+			if (!ResolveGeometrySource(Asset, *RuntimeOBJCacheData, bParseGeometry ? &EntriesChunks : nullptr))
+			{
+				return nullptr;
+			}
+			RuntimeOBJCacheData->bSourceResolved = true;
+		}
+
+		if (!bParseGeometry)
+		{
+			return RuntimeOBJCacheData;
+		}
+
+		FglTFRuntimeOBJLines& GeometryLines = RuntimeOBJCacheData->GeometryLines;
+		const TArray<FglTFRuntimeOBJEntry>& Entries = RuntimeOBJCacheData->Entries;
+		FglTFRuntimeParser& Parser = *(Asset->GetParser());
+		const FglTFRuntimeOBJGeometryTransform Transform(Parser);
+
+		// parse newline-aligned chunks concurrently (never crossing archive entries), then merge them preserving the file order
+		TArray<FglTFRuntimeOBJChunk> Chunks;
+		if (EntriesChunks.Num() > 0)
+		{
+			for (int32 EntryIndex = 0; EntryIndex < EntriesChunks.Num(); EntryIndex++)
+			{
+				for (FglTFRuntimeOBJChunk& Chunk : EntriesChunks[EntryIndex])
+				{
+					Chunk.Entry = EntryIndex;
+					Chunks.Add(MoveTemp(Chunk));
+				}
+			}
+
+			// move the lines from the entry to the geometry blob
+			ParallelFor(Chunks.Num(), [&](const int32 ChunkIndex)
+				{
+					FglTFRuntimeOBJChunk& Chunk = Chunks[ChunkIndex];
+					// inflated (non archive) sources have no entries
+					const int64 EntryOffset = Entries.IsValidIndex(Chunk.Entry) ? Entries[Chunk.Entry].Offset : 0;
+					Chunk.Start += EntryOffset;
+					Chunk.End += EntryOffset;
+					for (FglTFRuntimeOBJLine& ChunkLine : Chunk.Lines)
+					{
+						ChunkLine.Offset += EntryOffset;
+					}
+				});
+		}
+		else if (Entries.Num() > 1)
+		{
+			for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+			{
+				TArray<FglTFRuntimeOBJChunk> EntryChunks;
+				SplitBlobInChunks(GeometryLines.Data + Entries[EntryIndex].Offset, Entries[EntryIndex].Size, EntryChunks);
+				for (FglTFRuntimeOBJChunk& Chunk : EntryChunks)
+				{
+					Chunk.Start += Entries[EntryIndex].Offset;
+					Chunk.End += Entries[EntryIndex].Offset;
+					Chunk.Entry = EntryIndex;
+					Chunks.Add(MoveTemp(Chunk));
+				}
+			}
+
+			ParallelFor(Chunks.Num(), [&](const int32 ChunkIndex)
+				{
+					ParseGeometryChunk(GeometryLines.Data, Chunks[ChunkIndex], Transform);
+				});
+		}
+		else
+		{
+			ParseChunks(GeometryLines.Data, GeometryLines.Size, Chunks, Transform);
+		}
+
+		TArray<int32> ChunkLineBases;
+		int32 NumLines = 0;
+		for (const FglTFRuntimeOBJChunk& Chunk : Chunks)
+		{
+			ChunkLineBases.Add(NumLines);
+			NumLines += Chunk.Lines.Num();
+		}
+
+		TArray<FString> MaterialLibraries;
+
+		RuntimeOBJCacheData->ObjectNames.Empty();
+		RuntimeOBJCacheData->ObjectRanges.Empty();
+		RuntimeOBJCacheData->MaterialUseLines.Empty();
+		RuntimeOBJCacheData->bValidAttributes = true;
+
+		/*
+		 * Build the object index and load material libraries from the chunk events.
+		 * An object ends at the first "o" line following at least one face, so "o" lines
+		 * without faces are still mapped to the faces that follow them.
+		 */
+		TArray<FglTFRuntimeOBJObjectRange> PendingRanges;
+		TArray<FString> PendingNames;
+		bool bHasFacesSinceLastObject = false;
+
+		// archives with multiple .obj files expose each entry (whole) and its objects ("Entry/Object")
+		const bool bMultipleEntries = Entries.Num() > 1;
+		int32 CurrentEntry = -1;
+		FglTFRuntimeOBJObjectRange EntryRange;
+
+		// the unnamed object starts at the beginning of the file (of the first entry for archives, see below)
+		if (!bMultipleEntries)
+		{
+			PendingRanges.AddDefaulted();
+			PendingNames.Add("");
+		}
+
+		auto ClosePendingRanges = [&](const int32 LastLine)
+			{
+				for (int32 PendingIndex = 0; PendingIndex < PendingRanges.Num(); PendingIndex++)
+				{
+					PendingRanges[PendingIndex].LastLine = LastLine;
+					if (!RuntimeOBJCacheData->ObjectRanges.Contains(PendingNames[PendingIndex]))
+					{
+						RuntimeOBJCacheData->ObjectRanges.Add(PendingNames[PendingIndex], PendingRanges[PendingIndex]);
+					}
+				}
+				PendingRanges.Empty();
+				PendingNames.Empty();
+			};
+
+		auto CloseEntry = [&](const int32 LastLine)
+			{
+				ClosePendingRanges(LastLine);
+				EntryRange.LastLine = LastLine;
+				if (!RuntimeOBJCacheData->ObjectRanges.Contains(Entries[CurrentEntry].Name))
+				{
+					RuntimeOBJCacheData->ObjectRanges.Add(Entries[CurrentEntry].Name, EntryRange);
+				}
+			};
+
+		int32 VertexBase = 0;
+		int32 UVBase = 0;
+		int32 NormalBase = 0;
+
+		FglTFRuntimeOBJTokens Line;
+		for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ChunkIndex++)
+		{
+			const FglTFRuntimeOBJChunk& Chunk = Chunks[ChunkIndex];
+			if (!Chunk.bValidAttributes)
+			{
+				RuntimeOBJCacheData->bValidAttributes = false;
+			}
+
+			if (bMultipleEntries && Chunk.Entry != CurrentEntry)
+			{
+				const int32 EntryFirstLine = ChunkLineBases[ChunkIndex];
+				if (CurrentEntry >= 0)
+				{
+					CloseEntry(EntryFirstLine);
+				}
+
+				const bool bFirstEntry = CurrentEntry < 0;
+				CurrentEntry = Chunk.Entry;
+				bHasFacesSinceLastObject = false;
+
+				EntryRange = FglTFRuntimeOBJObjectRange();
+				EntryRange.FirstLine = EntryFirstLine;
+				EntryRange.VertexBase = EntryRange.EntryVertexBase = VertexBase;
+				EntryRange.UVBase = EntryRange.EntryUVBase = UVBase;
+				EntryRange.NormalBase = EntryRange.EntryNormalBase = NormalBase;
+				RuntimeOBJCacheData->ObjectNames.Add(Entries[CurrentEntry].Name);
+
+				// the unnamed object of the first entry is still reachable as "" (not listed, like single files)
+				if (bFirstEntry)
+				{
+					PendingRanges.Add(EntryRange);
+					PendingNames.Add("");
+				}
+			}
+
+			for (const FglTFRuntimeOBJChunkEvent& Event : Chunk.Events)
+			{
+				const int32 LineIndex = ChunkLineBases[ChunkIndex] + Event.LineIndex;
+
+				if (Event.Type == EglTFRuntimeOBJChunkEventType::Face)
+				{
+					bHasFacesSinceLastObject = true;
+					continue;
+				}
+
+				if (Event.Type == EglTFRuntimeOBJChunkEventType::MaterialUse)
+				{
+					RuntimeOBJCacheData->MaterialUseLines.Add(LineIndex);
+					continue;
+				}
+
+				FglTFRuntimeOBJLines::Tokenize(GeometryLines.Data, Chunk.Lines[Event.LineIndex], Line);
+
+				// object
+				if (Event.Type == EglTFRuntimeOBJChunkEventType::Object)
+				{
+					if (bHasFacesSinceLastObject)
+					{
+						ClosePendingRanges(LineIndex);
+						bHasFacesSinceLastObject = false;
+					}
+
+					FglTFRuntimeOBJObjectRange ObjectRange;
+					ObjectRange.FirstLine = LineIndex + 1;
+					ObjectRange.VertexBase = VertexBase + Event.NumVertices;
+					ObjectRange.UVBase = UVBase + Event.NumUVs;
+					ObjectRange.NormalBase = NormalBase + Event.NumNormals;
+					ObjectRange.EntryVertexBase = EntryRange.EntryVertexBase;
+					ObjectRange.EntryUVBase = EntryRange.EntryUVBase;
+					ObjectRange.EntryNormalBase = EntryRange.EntryNormalBase;
+
+					const FString ObjectName = bMultipleEntries ? Entries[CurrentEntry].Name / GetRemainingString(Line, 1) : GetRemainingString(Line, 1);
+					PendingRanges.Add(ObjectRange);
+					PendingNames.Add(ObjectName);
+					RuntimeOBJCacheData->ObjectNames.Add(ObjectName);
+					continue;
+				}
+
+				// mtllib
+				if (Event.Type == EglTFRuntimeOBJChunkEventType::MaterialLibrary)
+				{
+					MaterialLibraries.Add(GetRemainingString(Line, 1));
+				}
+			}
+
+			VertexBase += Chunk.Vertices.Num();
+			UVBase += Chunk.UVs.Num();
+			NormalBase += Chunk.Normals.Num();
+		}
+
+		MergeChunkArrays(GeometryLines.Lines, Chunks, &FglTFRuntimeOBJChunk::Lines);
+		MergeChunkColors(RuntimeOBJCacheData->Colors, Chunks);
+		MergeChunkPools(RuntimeOBJCacheData->Vertices, Chunks, &FglTFRuntimeOBJChunk::Vertices);
+		MergeChunkPools(RuntimeOBJCacheData->UVs, Chunks, &FglTFRuntimeOBJChunk::UVs);
+		MergeChunkPools(RuntimeOBJCacheData->Normals, Chunks, &FglTFRuntimeOBJChunk::Normals);
+
+
+		const FVector AxisX = Parser.TransformVector(FVector(1, 0, 0));
+		const FVector AxisY = Parser.TransformVector(FVector(0, 1, 0));
+		const FVector AxisZ = Parser.TransformVector(FVector(0, 0, 1));
+		RuntimeOBJCacheData->bMirrored = FVector::DotProduct(AxisX, FVector::CrossProduct(AxisY, AxisZ)) < 0;
+
+		if (bMultipleEntries && CurrentEntry >= 0)
+		{
+			CloseEntry(GeometryLines.Num());
+		}
+		else
+		{
+			ClosePendingRanges(GeometryLines.Num());
+		}
+
+		if (RuntimeOBJCacheData->ObjectNames.Num() == 0)
+		{
+			// add an empty entry for assets without objects
+			RuntimeOBJCacheData->ObjectNames.Add("");
+		}
+
+		if (Stats)
+		{
+			Stats->ParseTime = static_cast<float>(FPlatformTime::Seconds() - ParseStartTime);
+		}
+
+		LoadMaterialLibraries(Asset, *RuntimeOBJCacheData, MaterialLibraries, Stats);
+
+		RuntimeOBJCacheData->bValid = true;
+
+		return RuntimeOBJCacheData;
+	}
+
+	FString GetObjectCacheKey(const FString& ObjectName, const FglTFRuntimeOBJConfig& OBJConfig)
+	{
+		return FString::Printf(TEXT("%s@%d%d%d"), *ObjectName, OBJConfig.bDeduplicateVertices ? 1 : 0, OBJConfig.bGenerateNormals ? 1 : 0, OBJConfig.bGenerateTangents ? 1 : 0);
+	}
+
+	uint64 GetGeometryHash(UglTFRuntimeAsset* Asset, FglTFRuntimeOBJCacheData& RuntimeOBJCacheData)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_GetGeometryHash);
+
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		if (!RuntimeOBJCacheData.GeometryHash.IsSet())
+		{
+			const uint8* Data = RuntimeOBJCacheData.GeometryLines.Data;
+			const int64 Size = RuntimeOBJCacheData.GeometryLines.Size;
+
+			// fixed-size blocks keep the hash independent from the number of cores
+			constexpr int64 BlockSize = 16 * 1024 * 1024;
+			const int32 NumBlocks = FMath::Max<int32>(1, static_cast<int32>((Size + BlockSize - 1) / BlockSize));
+
+			TArray<uint64> BlockHashes;
+			BlockHashes.AddZeroed(NumBlocks);
+			ParallelFor(NumBlocks, [&](const int32 BlockIndex)
+				{
+					const int64 Start = BlockIndex * BlockSize;
+					const int64 Length = FMath::Min(BlockSize, Size - Start);
+					BlockHashes[BlockIndex] = CityHash64(reinterpret_cast<const char*>(Data + Start), static_cast<uint32>(Length));
+				});
+
+			RuntimeOBJCacheData.GeometryHash = CityHash64WithSeed(reinterpret_cast<const char*>(BlockHashes.GetData()), BlockHashes.Num() * sizeof(uint64), Size);
+		}
+
+		return RuntimeOBJCacheData.GeometryHash.GetValue();
+	}
+
+	FString GetDiskCacheFilename(UglTFRuntimeAsset* Asset, FglTFRuntimeOBJCacheData& RuntimeOBJCacheData, const FString& ObjectName, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+	{
+		FglTFRuntimeParser& Parser = *(Asset->GetParser());
+
+		auto VectorToString = [](const FVector& Vector)
+			{
+				return FString::Printf(TEXT("%.9g,%.9g,%.9g"), Vector.X, Vector.Y, Vector.Z);
+			};
+
+		// the parser transform is probed, so any change of basis or scale invalidates the entry
+		const FString Key = FString::Printf(TEXT("%016llx|%s|%d|%s|%s|%s|%s"),
+			GetGeometryHash(Asset, RuntimeOBJCacheData),
+			*GetObjectCacheKey(ObjectName, OBJConfig),
+			MaterialsConfig.bMergeSectionsByMaterial ? 1 : 0,
+			*VectorToString(Parser.TransformPosition(FVector::ZeroVector)),
+			*VectorToString(Parser.TransformVector(FVector(1, 0, 0))),
+			*VectorToString(Parser.TransformVector(FVector(0, 1, 0))),
+			*VectorToString(Parser.TransformVector(FVector(0, 0, 1))));
+
+		FTCHARToUTF8 KeyUTF8(*Key);
+		return FPaths::Combine(OBJConfig.DiskCacheDirectory, FString::Printf(TEXT("%016llx.objcache"), CityHash64(KeyUTF8.Get(), KeyUTF8.Length())));
+	}
+
+	/*
+	 * Every corner must turn the same way around the (Newell) polygon normal, and the
+	 * projected edges can change direction along an axis at most twice (this rejects star polygons).
+	 */
+	bool IsConvexPolygon(const FglTFRuntimeOBJVectorPool& Vertices, const TArray<TStaticArray<TPair<uint32, bool>, 3>>& PolygonIndices)
+	{
+		const int32 NumVertices = PolygonIndices.Num();
+
+		FVector Normal = FVector::ZeroVector;
+		for (int32 Index = 0; Index < NumVertices; Index++)
+		{
+			const FVector& Current = Vertices[PolygonIndices[Index][0].Key];
+			const FVector& Next = Vertices[PolygonIndices[(Index + 1) % NumVertices][0].Key];
+			Normal.X += (Current.Y - Next.Y) * (Current.Z + Next.Z);
+			Normal.Y += (Current.Z - Next.Z) * (Current.X + Next.X);
+			Normal.Z += (Current.X - Next.X) * (Current.Y + Next.Y);
+		}
+
+		if (!Normal.Normalize())
+		{
+			return false;
+		}
+
+		FVector AxisU;
+		FVector AxisV;
+		Normal.FindBestAxisVectors(AxisU, AxisV);
+
+		int32 NumDirectionChanges = 0;
+		double FirstDirection = 0;
+		double LastDirection = 0;
+
+		for (int32 Index = 0; Index < NumVertices; Index++)
+		{
+			const FVector& Previous = Vertices[PolygonIndices[(Index + NumVertices - 1) % NumVertices][0].Key];
+			const FVector& Current = Vertices[PolygonIndices[Index][0].Key];
+			const FVector& Next = Vertices[PolygonIndices[(Index + 1) % NumVertices][0].Key];
+
+			if (FVector::DotProduct(FVector::CrossProduct(Current - Previous, Next - Current), Normal) < 0)
+			{
+				return false;
+			}
+
+			const double Direction = FVector::DotProduct(Next - Current, AxisU);
+			if (Direction == 0)
+			{
+				continue;
+			}
+
+			if (LastDirection == 0)
+			{
+				FirstDirection = Direction;
+			}
+			else if ((Direction > 0) != (LastDirection > 0))
+			{
+				NumDirectionChanges++;
+			}
+			LastDirection = Direction;
+		}
+
+		if ((FirstDirection > 0) != (LastDirection > 0))
+		{
+			NumDirectionChanges++;
+		}
+
+		return NumDirectionChanges <= 2;
+	}
+
+	/*
+	 * Appends the triangles of a polygon (more than 3 vertices) preserving its winding.
+	 * Convex quads are split along the shorter diagonal, convex n-gons are fanned and
+	 * only concave polygons go through the ear clipping triangulator.
+	 * PolygonVertices and Triangles are scratch buffers reused between faces.
+	 */
+#if ENGINE_MAJOR_VERSION >= 5
+	void TriangulatePolygon(const FglTFRuntimeOBJVectorPool& Vertices, const TArray<TStaticArray<TPair<uint32, bool>, 3>>& PolygonIndices, TArray<TStaticArray<TPair<uint32, bool>, 3>>& Indices, TArray<FVector>& PolygonVertices, TArray<UE::Geometry::FIndex3i>& Triangles)
+#else
+	void TriangulatePolygon(const FglTFRuntimeOBJVectorPool& Vertices, const TArray<TStaticArray<TPair<uint32, bool>, 3>>& PolygonIndices, TArray<TStaticArray<TPair<uint32, bool>, 3>>& Indices, TArray<FVector3<float>>& PolygonVertices, TArray<FIndex3i>& Triangles)
+#endif
+	{
+		const int32 NumVertices = PolygonIndices.Num();
+
+		if (IsConvexPolygon(Vertices, PolygonIndices))
+		{
+			int32 First = 0;
+			if (NumVertices == 4)
+			{
+				const double Diagonal02 = FVector::DistSquared(Vertices[PolygonIndices[0][0].Key], Vertices[PolygonIndices[2][0].Key]);
+				const double Diagonal13 = FVector::DistSquared(Vertices[PolygonIndices[1][0].Key], Vertices[PolygonIndices[3][0].Key]);
+				First = Diagonal13 < Diagonal02 ? 1 : 0;
+			}
+
+			for (int32 Index = 1; Index < NumVertices - 1; Index++)
+			{
+				Indices.Add(PolygonIndices[First]);
+				Indices.Add(PolygonIndices[(First + Index) % NumVertices]);
+				Indices.Add(PolygonIndices[(First + Index + 1) % NumVertices]);
+			}
+			return;
+		}
+
+		PolygonVertices.Reset();
+		for (const TStaticArray<TPair<uint32, bool>, 3>& PolygonIndex : PolygonIndices)
+		{
+			PolygonVertices.Add(Vertices[PolygonIndex[0].Key]);
+		}
+
+		Triangles.Reset();
+		PolygonTriangulation::TriangulateSimplePolygon(PolygonVertices, Triangles);
+
+#if ENGINE_MAJOR_VERSION >= 5
+		for (const UE::Geometry::FIndex3i& Triangle : Triangles)
+#else
+		for (const FIndex3i& Triangle : Triangles)
+#endif
+		{
+			Indices.Add(PolygonIndices[Triangle.A]);
+			Indices.Add(PolygonIndices[Triangle.C]);
+			Indices.Add(PolygonIndices[Triangle.B]);
+		}
+	}
+
+	/*
+	 * Area weighted face normals, accumulated per position and smoothing group.
+	 * Faces in smoothing group 0 (or "s off") are flat shaded.
+	 */
+	void ComputeFaceNormals(const TArray<TStaticArray<TPair<uint32, bool>, 3>>& Indices, const TArray<uint32>& SmoothingGroups, const FglTFRuntimeOBJVectorPool& Vertices, const bool bMirrored, TArray<FVector>& FaceNormals, TMap<TPair<uint32, uint32>, FVector>& SmoothNormals)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_ComputeFaceNormals);
+
+		const int32 NumTriangles = Indices.Num() / 3;
+		FaceNormals.SetNumUninitialized(NumTriangles);
+
+		for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
+		{
+			const uint32 VertexIndices[3] = { Indices[TriangleIndex * 3][0].Key, Indices[TriangleIndex * 3 + 1][0].Key, Indices[TriangleIndex * 3 + 2][0].Key };
+			if (!Vertices.IsValidIndex(VertexIndices[0]) || !Vertices.IsValidIndex(VertexIndices[1]) || !Vertices.IsValidIndex(VertexIndices[2]))
+			{
+				FaceNormals[TriangleIndex] = FVector::ZeroVector;
+				continue;
+			}
+
+			const FVector A = Vertices[VertexIndices[0]];
+			const FVector B = Vertices[VertexIndices[1]];
+			const FVector C = Vertices[VertexIndices[2]];
+			const FVector FaceNormal = bMirrored ? FVector::CrossProduct(C - A, B - A) : FVector::CrossProduct(B - A, C - A);
+			FaceNormals[TriangleIndex] = FaceNormal;
+
+			const uint32 SmoothingGroup = SmoothingGroups.IsValidIndex(TriangleIndex) ? SmoothingGroups[TriangleIndex] : 0;
+			if (SmoothingGroup != 0)
+			{
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					SmoothNormals.FindOrAdd(TPair<uint32, uint32>(VertexIndices[Corner], SmoothingGroup), FVector::ZeroVector) += FaceNormal;
+				}
+			}
+		}
+	}
+
+	// per vertex tangents from the UV gradients of the triangles sharing it, orthogonalized against the normal
+	void ComputeTangents(FglTFRuntimePrimitive& Primitive, const bool bMirrored)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_ComputeTangents);
+
+		const int32 NumVertices = Primitive.Positions.Num();
+		if (Primitive.UVs.Num() < 1 || Primitive.UVs[0].Num() != NumVertices || Primitive.Normals.Num() != NumVertices)
+		{
+			return;
+		}
+
+		TArray<FVector> Tangents;
+		TArray<FVector> Bitangents;
+		Tangents.AddZeroed(NumVertices);
+		Bitangents.AddZeroed(NumVertices);
+
+		for (int32 Index = 0; Index + 2 < Primitive.Indices.Num(); Index += 3)
+		{
+			const uint32 I0 = Primitive.Indices[Index];
+			const uint32 I1 = Primitive.Indices[Index + 1];
+			const uint32 I2 = Primitive.Indices[Index + 2];
+
+			const FVector Edge1 = Primitive.Positions[I1] - Primitive.Positions[I0];
+			const FVector Edge2 = Primitive.Positions[I2] - Primitive.Positions[I0];
+			const FVector2D DeltaUV1 = Primitive.UVs[0][I1] - Primitive.UVs[0][I0];
+			const FVector2D DeltaUV2 = Primitive.UVs[0][I2] - Primitive.UVs[0][I0];
+
+			const double Determinant = DeltaUV1.X * DeltaUV2.Y - DeltaUV2.X * DeltaUV1.Y;
+			if (FMath::Abs(Determinant) < SMALL_NUMBER)
+			{
+				continue;
+			}
+
+			const FVector Tangent = (Edge1 * DeltaUV2.Y - Edge2 * DeltaUV1.Y) / Determinant;
+			const FVector Bitangent = (Edge2 * DeltaUV1.X - Edge1 * DeltaUV2.X) / Determinant;
+
+			for (const uint32 VertexIndex : { I0, I1, I2 })
+			{
+				Tangents[VertexIndex] += Tangent;
+				Bitangents[VertexIndex] += Bitangent;
+			}
+		}
+
+		Primitive.Tangents.SetNumUninitialized(NumVertices);
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			const FVector& Normal = Primitive.Normals[VertexIndex];
+			FVector Tangent = (Tangents[VertexIndex] - Normal * FVector::DotProduct(Normal, Tangents[VertexIndex])).GetSafeNormal();
+			if (Tangent.IsNearlyZero())
+			{
+				FVector Bitangent;
+				Normal.FindBestAxisVectors(Tangent, Bitangent);
+			}
+
+			// the sign is expressed in the source (glTF-like) handedness, as for loaded tangents
+			float Sign = FVector::DotProduct(FVector::CrossProduct(Normal, Tangent), Bitangents[VertexIndex]) < 0 ? -1 : 1;
+			if (bMirrored)
+			{
+				Sign = -Sign;
+			}
+
+			Primitive.Tangents[VertexIndex] = FVector4(Tangent, Sign);
+		}
+	}
+
+	void FixPrimitive(FglTFRuntimePrimitive& Primitive, const TArray<TStaticArray<TPair<uint32, bool>, 3>>& Indices, const TArray<uint32>& SmoothingGroups, const FglTFRuntimeOBJCacheData& RuntimeOBJCacheData, const FglTFRuntimeOBJConfig& OBJConfig)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_FixPrimitive);
+
+		const FglTFRuntimeOBJVectorPool& Vertices = RuntimeOBJCacheData.Vertices;
+		const FglTFRuntimeOBJVectorPool& Normals = RuntimeOBJCacheData.Normals;
+		const FglTFRuntimeOBJUVPool& UVs = RuntimeOBJCacheData.UVs;
+		const FglTFRuntimeOBJColorPool& Colors = RuntimeOBJCacheData.Colors;
+
+		if (UVs.Num() > 0)
+		{
+			Primitive.UVs.AddDefaulted();
+		}
+
+		const bool bHasNormals = Normals.Num() > 0 || OBJConfig.bGenerateNormals;
+
+		// generated normals for the corners without a vn
+		TArray<FVector> FaceNormals;
+		TMap<TPair<uint32, uint32>, FVector> SmoothNormals;
+		if (OBJConfig.bGenerateNormals)
+		{
+			ComputeFaceNormals(Indices, SmoothingGroups, Vertices, RuntimeOBJCacheData.bMirrored, FaceNormals, SmoothNormals);
+		}
+
+		// maps a resolved v/vt/vn triple to the already emitted vertex
+		TMap<FglTFRuntimeOBJVertexKey, uint32> UniqueVertices;
+		if (OBJConfig.bDeduplicateVertices)
+		{
+			UniqueVertices.Reserve(Indices.Num());
+		}
+
+		Primitive.Indices.Reserve(Primitive.Indices.Num() + Indices.Num());
+
+		for (int32 Index = 0; Index < Indices.Num(); Index++)
+		{
+			const uint32 VertexIndex = Indices[Index][0].Key;
+			const bool bHasVertex = Indices[Index][0].Value;
+			if (!bHasVertex)
+			{
+				continue;
+			}
+
+			if (!Vertices.IsValidIndex(VertexIndex))
+			{
+				continue;
+			}
+
+			FglTFRuntimeOBJVertexKey VertexKey;
+			VertexKey.Vertex = VertexIndex;
+
+			if (UVs.Num() > 0)
+			{
+				const uint32 UVIndex = Indices[Index][1].Key;
+				const bool bHasUV = Indices[Index][1].Value;
+
+				if (bHasUV && UVs.IsValidIndex(UVIndex))
+				{
+					VertexKey.UV = UVIndex;
+				}
+			}
+
+			if (Normals.Num() > 0)
+			{
+				const uint32 NormalIndex = Indices[Index][2].Key;
+				const bool bHasNormal = Indices[Index][2].Value;
+
+				if (bHasNormal && Normals.IsValidIndex(NormalIndex))
+				{
+					VertexKey.Normal = NormalIndex;
+				}
+			}
+
+			if (OBJConfig.bGenerateNormals && VertexKey.Normal == MAX_uint32)
+			{
+				const int32 TriangleIndex = Index / 3;
+				VertexKey.SmoothingGroup = SmoothingGroups.IsValidIndex(TriangleIndex) ? SmoothingGroups[TriangleIndex] : 0;
+				if (VertexKey.SmoothingGroup == 0)
+				{
+					VertexKey.Triangle = TriangleIndex;
+				}
+			}
+
+			if (OBJConfig.bDeduplicateVertices)
+			{
+				if (const uint32* UniqueIndex = UniqueVertices.Find(VertexKey))
+				{
+					Primitive.Indices.Add(*UniqueIndex);
+					continue;
+				}
+			}
+
+			const int32 PositionIndex = Primitive.Positions.Add(Vertices[VertexIndex]);
+
+			if (UVs.Num() > 0)
+			{
+				Primitive.UVs[0].Add(VertexKey.UV != MAX_uint32 ? UVs[VertexKey.UV] : FVector2D::ZeroVector);
+			}
+
+			if (bHasNormals)
+			{
+				FVector Normal = FVector::ZAxisVector;
+				if (VertexKey.Normal != MAX_uint32)
+				{
+					Normal = Normals[VertexKey.Normal];
+				}
+				else if (OBJConfig.bGenerateNormals)
+				{
+					const FVector& GeneratedNormal = VertexKey.SmoothingGroup != 0 ? SmoothNormals.FindChecked(TPair<uint32, uint32>(VertexIndex, VertexKey.SmoothingGroup)) : FaceNormals[Index / 3];
+					if (!GeneratedNormal.IsNearlyZero(SMALL_NUMBER))
+					{
+						Normal = GeneratedNormal.GetSafeNormal();
+					}
+				}
+				Primitive.Normals.Add(Normal);
+			}
+
+			// colors follow the position index, so they do not need to be part of the deduplication key
+			if (Colors.Num() > 0)
+			{
+				Primitive.Colors.Add(Colors[VertexIndex]);
+			}
+
+			if (OBJConfig.bDeduplicateVertices)
+			{
+				UniqueVertices.Add(VertexKey, PositionIndex);
+			}
+
+			Primitive.Indices.Add(PositionIndex);
+		}
+
+		if (OBJConfig.bGenerateTangents)
+		{
+			ComputeTangents(Primitive, RuntimeOBJCacheData.bMirrored);
+		}
+	}
+
+	FString GetMaterialsConfigKey(const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+	{
+		FString MaterialsConfigJson;
+		FJsonObjectConverter::UStructToJsonObjectString(MaterialsConfig, MaterialsConfigJson);
+		return FString::Printf(TEXT("%08X"), FCrc::StrCrc32(*MaterialsConfigJson));
+	}
+
+	// skips the options (-bm 0.5, -s 1 1 1, ...) preceding the filename of a map_* line
+	FString GetTextureFilename(const FglTFRuntimeOBJTokens& Line)
+	{
+		int32 Index = 1;
+		while (Line.IsValidIndex(Index) && Line[Index].Len() > 1 && Line[Index][0] == '-')
+		{
+			int32 NumArguments = 1;
+			if (IsToken(Line[Index], "-s") || IsToken(Line[Index], "-o") || IsToken(Line[Index], "-t"))
+			{
+				NumArguments = 3;
+			}
+			else if (IsToken(Line[Index], "-mm"))
+			{
+				NumArguments = 2;
+			}
+			Index += 1 + NumArguments;
+		}
+
+		return GetRemainingString(Line, Index);
+	}
+
+	FString GetTextureKey(const FglTFRuntimeOBJTextureRequest& TextureRequest, const FString& MaterialsConfigKey)
+	{
+		return FString::Printf(TEXT("%s@%d@%s"), *TextureRequest.Filename, TextureRequest.bSRGB ? 1 : 0, *MaterialsConfigKey);
+	}
+
+	// parses the material factors, textures are only collected in TextureRequests
+	void FillMaterial(FglTFRuntimeOBJCacheData& RuntimeOBJCacheData, const int32 StartingLine, FglTFRuntimeOBJPendingMaterial& PendingMaterial)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_FillMaterial);
+		SCOPE_CYCLE_COUNTER(STAT_glTFRuntimeOBJ_FillMaterial);
+
+		FglTFRuntimeMaterial& Material = PendingMaterial.Material.Get();
+
+		FglTFRuntimeOBJTokens Line;
+
+		Material.MaterialType = EglTFRuntimeMaterialType::TwoSided;
+
+		auto AddTexture = [&](const EglTFRuntimeOBJTextureSlot Slot, const bool bSRGB)
+			{
+				const FString Filename = GetTextureFilename(Line);
+				if (Filename.IsEmpty())
+				{
+					return;
+				}
+
+				PendingMaterial.TextureRequests.RemoveAll([Slot](const FglTFRuntimeOBJTextureRequest& TextureRequest) { return TextureRequest.Slot == Slot; });
+				PendingMaterial.TextureRequests.Add({ Slot, Filename, bSRGB });
+			};
+
+		bool bHasNormalMap = false;
+
+		// fill material
+		for (int32 LineIndex = StartingLine; LineIndex < RuntimeOBJCacheData.MaterialLines.Num(); LineIndex++)
+		{
+			RuntimeOBJCacheData.MaterialLines.Tokenize(LineIndex, Line);
+			if (IsToken(Line[0], "newmtl"))
+			{
+				break;
+			}
+
+			if (IsToken(Line[0], "Kd"))
+			{
+				if (Line.Num() >= 4)
+				{
+					Material.bHasBaseColorFactor = true;
+					Material.BaseColorFactor.R = TokenToDouble(Line[1]);
+					Material.BaseColorFactor.G = TokenToDouble(Line[2]);
+					Material.BaseColorFactor.B = TokenToDouble(Line[3]);
+				}
+				continue;
+			}
+
+			if (IsToken(Line[0], "Ks"))
+			{
+				if (Line.Num() >= 4)
+				{
+					PendingMaterial.SpecularFactor = FLinearColor(TokenToDouble(Line[1]), TokenToDouble(Line[2]), TokenToDouble(Line[3]));
+				}
+				continue;
+			}
+
+			if (IsToken(Line[0], "d"))
+			{
+				if (Line.Num() >= 2)
+				{
+					Material.BaseColorFactor.A = TokenToDouble(Line[1]);
+					if (Material.BaseColorFactor.A < 1)
+					{
+						Material.bTranslucent = true;
+						Material.MaterialType = EglTFRuntimeMaterialType::TwoSidedTranslucent;
+					}
+				}
+				continue;
+			}
+
+			if (IsToken(Line[0], "Tr"))
+			{
+				if (Line.Num() >= 2)
+				{
+					Material.BaseColorFactor.A = 1 - TokenToDouble(Line[1]);
+					if (Material.BaseColorFactor.A < 1)
+					{
+						Material.bTranslucent = true;
+						Material.MaterialType = EglTFRuntimeMaterialType::TwoSidedTranslucent;
+					}
+				}
+				continue;
+			}
+
+			if (IsToken(Line[0], "Ns"))
+			{
+				if (Line.Num() >= 2)
+				{
+					Material.BaseSpecularFactor = TokenToDouble(Line[1]) / 1000;
+				}
+				continue;
+			}
+
+			// PBR extension
+			if (IsToken(Line[0], "Pr"))
+			{
+				if (Line.Num() >= 2)
+				{
+					PendingMaterial.RoughnessFactor = TokenToDouble(Line[1]);
+				}
+				continue;
+			}
+
+			if (IsToken(Line[0], "Pm"))
+			{
+				if (Line.Num() >= 2)
+				{
+					PendingMaterial.MetallicFactor = TokenToDouble(Line[1]);
+				}
+				continue;
+			}
+
+			if (IsToken(Line[0], "map_Kd"))
+			{
+				AddTexture(EglTFRuntimeOBJTextureSlot::BaseColor, true);
+				continue;
+			}
+
+			// "norm" is a real normal map, so it wins over bump maps
+			if (IsToken(Line[0], "norm"))
+			{
+				AddTexture(EglTFRuntimeOBJTextureSlot::Normal, false);
+				bHasNormalMap = true;
+				continue;
+			}
+
+			if (IsToken(Line[0], "map_Bump") || IsToken(Line[0], "bump"))
+			{
+				if (!bHasNormalMap)
+				{
+					AddTexture(EglTFRuntimeOBJTextureSlot::Normal, false);
+				}
+				continue;
+			}
+
+			if (IsToken(Line[0], "map_d"))
+			{
+				AddTexture(EglTFRuntimeOBJTextureSlot::Alpha, false);
+				continue;
+			}
+
+			if (IsToken(Line[0], "map_Pr"))
+			{
+				AddTexture(EglTFRuntimeOBJTextureSlot::Roughness, false);
+				continue;
+			}
+
+			if (IsToken(Line[0], "map_Pm"))
+			{
+				AddTexture(EglTFRuntimeOBJTextureSlot::Metallic, false);
+				continue;
+			}
+
+			if (IsToken(Line[0], "map_Ks"))
+			{
+				AddTexture(EglTFRuntimeOBJTextureSlot::Specular, true);
+				continue;
+			}
+
+			if (IsToken(Line[0], "map_Ns"))
+			{
+				AddTexture(EglTFRuntimeOBJTextureSlot::Glossiness, false);
+				continue;
+			}
+		}
+	}
+
+	bool IsPackableMip(const TArray<FglTFRuntimeMipMap>* Mips)
+	{
+		return Mips && Mips->Num() > 0 && (*Mips)[0].PixelFormat == PF_B8G8R8A8 && (*Mips)[0].Width > 0 && (*Mips)[0].Height > 0 && (*Mips)[0].Pixels.Num() >= static_cast<int64>((*Mips)[0].Width) * (*Mips)[0].Height * 4;
+	}
+
+	// appends the BGRA8 mip chain (2x2 box filter) down to 1x1 after the first mip
+	void GenerateMipChain(TArray<FglTFRuntimeMipMap>& Mips)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_GenerateMipChain);
+
+		while (Mips.Last().Width > 1 || Mips.Last().Height > 1)
+		{
+			const FglTFRuntimeMipMap& Source = Mips.Last();
+			const int32 SourceWidth = Source.Width;
+			const int32 SourceHeight = Source.Height;
+
+			FglTFRuntimeMipMap Mip(-1);
+			Mip.PixelFormat = PF_B8G8R8A8;
+			Mip.Width = FMath::Max(SourceWidth / 2, 1);
+			Mip.Height = FMath::Max(SourceHeight / 2, 1);
+			Mip.Pixels.AddUninitialized(static_cast<int64>(Mip.Width) * Mip.Height * 4);
+
+			const uint8* SourcePixels = Source.Pixels.GetData();
+			ParallelFor(Mip.Height, [&](const int32 Y)
+				{
+					const int64 Y0 = FMath::Min(Y * 2, SourceHeight - 1);
+					const int64 Y1 = FMath::Min(Y * 2 + 1, SourceHeight - 1);
+					for (int32 X = 0; X < Mip.Width; X++)
+					{
+						const int64 X0 = FMath::Min(X * 2, SourceWidth - 1);
+						const int64 X1 = FMath::Min(X * 2 + 1, SourceWidth - 1);
+						uint8* Pixel = Mip.Pixels.GetData() + (static_cast<int64>(Y) * Mip.Width + X) * 4;
+						for (int32 Channel = 0; Channel < 4; Channel++)
+						{
+							const int32 Sum = SourcePixels[(Y0 * SourceWidth + X0) * 4 + Channel] + SourcePixels[(Y0 * SourceWidth + X1) * 4 + Channel] +
+								SourcePixels[(Y1 * SourceWidth + X0) * 4 + Channel] + SourcePixels[(Y1 * SourceWidth + X1) * 4 + Channel];
+							Pixel[Channel] = static_cast<uint8>((Sum + 2) / 4);
+						}
+					}
+				});
+
+			Mips.Add(MoveTemp(Mip));
+		}
+	}
+
+	/*
+	 * Builds a BGRA8 texture from the first mip of up to 4 sources (nearest sampled to the biggest one).
+	 * Each destination channel (B, G, R, A) takes a channel of a source or a constant if the source is missing.
+	 * The mip chain is generated when the sources have one (LoadBlobToMips generated it as requested by the materials config).
+	 */
+	void PackTextureChannels(TArray<FglTFRuntimeMipMap>& Mips, const TArray<FglTFRuntimeMipMap>* const (&Sources)[4], const int32 (&SourceChannels)[4], const uint8 (&DefaultValues)[4])
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_PackTextureChannels);
+
+		int32 Width = 1;
+		int32 Height = 1;
+		bool bGenerateMips = false;
+		for (int32 Channel = 0; Channel < 4; Channel++)
+		{
+			if (IsPackableMip(Sources[Channel]))
+			{
+				Width = FMath::Max(Width, (*Sources[Channel])[0].Width);
+				Height = FMath::Max(Height, (*Sources[Channel])[0].Height);
+				bGenerateMips |= Sources[Channel]->Num() > 1;
+			}
+		}
+
+		FglTFRuntimeMipMap Mip(-1);
+		Mip.PixelFormat = PF_B8G8R8A8;
+		Mip.Width = Width;
+		Mip.Height = Height;
+		Mip.Pixels.AddUninitialized(static_cast<int64>(Width) * Height * 4);
+
+		ParallelFor(Height, [&](const int32 Y)
+			{
+				for (int32 X = 0; X < Width; X++)
+				{
+					uint8* Pixel = Mip.Pixels.GetData() + (static_cast<int64>(Y) * Width + X) * 4;
+					for (int32 Channel = 0; Channel < 4; Channel++)
+					{
+						if (!IsPackableMip(Sources[Channel]))
+						{
+							Pixel[Channel] = DefaultValues[Channel];
+							continue;
+						}
+
+						const FglTFRuntimeMipMap& Source = (*Sources[Channel])[0];
+						const int64 SourceX = static_cast<int64>(X) * Source.Width / Width;
+						const int64 SourceY = static_cast<int64>(Y) * Source.Height / Height;
+						Pixel[Channel] = Source.Pixels[(SourceY * Source.Width + SourceX) * 4 + SourceChannels[Channel]];
+					}
+				}
+			});
+
+		Mips.Empty();
+		Mips.Add(MoveTemp(Mip));
+
+		if (bGenerateMips)
+		{
+			GenerateMipChain(Mips);
+		}
+	}
+
+	// wires the decoded textures into the material slots, packing the ones sharing a texture
+	void ApplyMaterialTextures(FglTFRuntimeOBJPendingMaterial& PendingMaterial, const TMap<FString, FglTFRuntimeOBJSharedMips>& TexturesMips, const FString& MaterialsConfigKey)
+	{
+		FglTFRuntimeMaterial& Material = PendingMaterial.Material.Get();
+
+		const TArray<FglTFRuntimeMipMap>* SlotsMips[static_cast<int32>(EglTFRuntimeOBJTextureSlot::Num)] = {};
+		for (const FglTFRuntimeOBJTextureRequest& TextureRequest : PendingMaterial.TextureRequests)
+		{
+			const FglTFRuntimeOBJSharedMips* Mips = TexturesMips.Find(GetTextureKey(TextureRequest, MaterialsConfigKey));
+			if (Mips && Mips->IsValid() && (*Mips)->Num() > 0)
+			{
+				SlotsMips[static_cast<int32>(TextureRequest.Slot)] = Mips->Get();
+			}
+		}
+
+		auto GetSlot = [&SlotsMips](const EglTFRuntimeOBJTextureSlot Slot)
+			{
+				return SlotsMips[static_cast<int32>(Slot)];
+			};
+
+		// BGRA8 channel indices
+		constexpr int32 B = 0;
+		constexpr int32 G = 1;
+		constexpr int32 R = 2;
+		constexpr int32 A = 3;
+
+		if (const TArray<FglTFRuntimeMipMap>* BaseColorMips = GetSlot(EglTFRuntimeOBJTextureSlot::BaseColor))
+		{
+			Material.BaseColorTextureMips = *BaseColorMips;
+		}
+
+		if (const TArray<FglTFRuntimeMipMap>* NormalMips = GetSlot(EglTFRuntimeOBJTextureSlot::Normal))
+		{
+			Material.NormalTextureMips = *NormalMips;
+		}
+
+		// map_d goes in the base color alpha
+		const TArray<FglTFRuntimeMipMap>* AlphaMips = GetSlot(EglTFRuntimeOBJTextureSlot::Alpha);
+		if (IsPackableMip(AlphaMips))
+		{
+			const TArray<FglTFRuntimeMipMap>* BaseColorMips = IsPackableMip(GetSlot(EglTFRuntimeOBJTextureSlot::BaseColor)) ? GetSlot(EglTFRuntimeOBJTextureSlot::BaseColor) : nullptr;
+			const TArray<FglTFRuntimeMipMap>* Sources[4] = { BaseColorMips, BaseColorMips, BaseColorMips, AlphaMips };
+			PackTextureChannels(Material.BaseColorTextureMips, Sources, { B, G, R, R }, { 255, 255, 255, 255 });
+			Material.bTranslucent = true;
+			Material.MaterialType = EglTFRuntimeMaterialType::TwoSidedTranslucent;
+		}
+
+		// map_Pr/map_Pm go in the G/B channels of the metallic roughness texture
+		const TArray<FglTFRuntimeMipMap>* RoughnessMips = GetSlot(EglTFRuntimeOBJTextureSlot::Roughness);
+		const TArray<FglTFRuntimeMipMap>* MetallicMips = GetSlot(EglTFRuntimeOBJTextureSlot::Metallic);
+		const bool bHasPBRTextures = IsPackableMip(RoughnessMips) || IsPackableMip(MetallicMips);
+		if (bHasPBRTextures)
+		{
+			const TArray<FglTFRuntimeMipMap>* Sources[4] = { MetallicMips, RoughnessMips, nullptr, nullptr };
+			PackTextureChannels(Material.MetallicRoughnessTextureMips, Sources, { R, R, R, R }, { 255, 255, 255, 255 });
+		}
+
+		// without a metallic map the texture channel is white, so the factor alone drives it (non metallic by default)
+		if (bHasPBRTextures || PendingMaterial.MetallicFactor.IsSet())
+		{
+			Material.bHasMetallicFactor = true;
+			Material.MetallicFactor = PendingMaterial.MetallicFactor.Get(IsPackableMip(MetallicMips) ? 1 : 0);
+		}
+
+		if (bHasPBRTextures || PendingMaterial.RoughnessFactor.IsSet())
+		{
+			Material.bHasRoughnessFactor = true;
+			Material.RoughnessFactor = PendingMaterial.RoughnessFactor.Get(1);
+		}
+
+		// map_Ks/map_Ns (only for non PBR materials) switch the material to specular glossiness
+		const TArray<FglTFRuntimeMipMap>* SpecularMips = GetSlot(EglTFRuntimeOBJTextureSlot::Specular);
+		const TArray<FglTFRuntimeMipMap>* GlossinessMips = GetSlot(EglTFRuntimeOBJTextureSlot::Glossiness);
+		const bool bIsPBR = bHasPBRTextures || PendingMaterial.MetallicFactor.IsSet() || PendingMaterial.RoughnessFactor.IsSet();
+		if (!bIsPBR && (IsPackableMip(SpecularMips) || IsPackableMip(GlossinessMips)))
+		{
+			const TArray<FglTFRuntimeMipMap>* Sources[4] = { SpecularMips, SpecularMips, SpecularMips, GlossinessMips };
+			PackTextureChannels(Material.SpecularGlossinessTextureMips, Sources, { B, G, R, R }, { 255, 255, 255, 255 });
+
+			Material.bKHR_materials_pbrSpecularGlossiness = true;
+			Material.bHasDiffuseFactor = Material.bHasBaseColorFactor;
+			Material.DiffuseFactor = Material.BaseColorFactor;
+			Material.DiffuseTextureMips = Material.BaseColorTextureMips;
+			Material.bHasSpecularFactor = true;
+			Material.SpecularFactor = IsPackableMip(SpecularMips) ? FLinearColor::White : PendingMaterial.SpecularFactor.Get(FLinearColor::White);
+			Material.bHasGlossinessFactor = true;
+			Material.GlossinessFactor = 1;
+		}
+	}
+
+	/*
+	 * Decodes (concurrently, each texture in its own task) the textures requested by the materials
+	 * that are not in the cache yet, and adds them to the cache.
+	 * Textures already decoded by any asset are only read for computing their content hash.
+	 */
+	void DecodeTextures(UglTFRuntimeAsset* Asset, FglTFRuntimeOBJCacheData& RuntimeOBJCacheData, const TArray<FglTFRuntimeOBJPendingMaterial>& PendingMaterials, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FString& MaterialsConfigKey, FglTFRuntimeOBJLoadStats* Stats)
+	{
+		TArray<FString> TextureKeys;
+		TArray<FglTFRuntimeOBJTextureRequest> TextureRequests;
+		{
+			FScopeLock Lock(&(RuntimeOBJCacheData.MaterialsLock));
+			for (const FglTFRuntimeOBJPendingMaterial& PendingMaterial : PendingMaterials)
+			{
+				for (const FglTFRuntimeOBJTextureRequest& TextureRequest : PendingMaterial.TextureRequests)
+				{
+					const FString TextureKey = GetTextureKey(TextureRequest, MaterialsConfigKey);
+					if (!RuntimeOBJCacheData.TexturesMips.Contains(TextureKey) && !TextureKeys.Contains(TextureKey))
+					{
+						TextureKeys.Add(TextureKey);
+						TextureRequests.Add(TextureRequest);
+					}
+				}
+			}
+		}
+
+		if (TextureRequests.Num() == 0)
+		{
+			return;
+		}
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_DecodeTextures);
+		FglTFRuntimeOBJScopeTimer Timer(Stats ? &Stats->TexturesTime : nullptr);
+
+		TArray<FglTFRuntimeOBJSharedMips> TexturesMips;
+		TexturesMips.AddDefaulted(TextureRequests.Num());
+		FThreadSafeCounter NumTexturesDecoded;
+
+		ParallelFor(TextureRequests.Num(), [&](const int32 TextureIndex)
+			{
+				const FglTFRuntimeOBJTextureRequest& TextureRequest = TextureRequests[TextureIndex];
+
+				TArray64<uint8> ImageData;
+				if (!Asset->GetParser()->LoadPathToBlob(TextureRequest.Filename, ImageData))
+				{
+					TexturesMips[TextureIndex] = MakeShared<TArray<FglTFRuntimeMipMap>, ESPMode::ThreadSafe>();
+					return;
+				}
+
+				const FString SharedTextureKey = GetSharedTextureKey(TextureRequest.Filename, ImageData, TextureRequest.bSRGB, MaterialsConfigKey);
+				TexturesMips[TextureIndex] = FindSharedTexture(SharedTextureKey);
+				if (TexturesMips[TextureIndex])
+				{
+					return;
+				}
+
+				TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_DecodeTexture);
+				SCOPE_CYCLE_COUNTER(STAT_glTFRuntimeOBJ_DecodeTexture);
+
+				TArray<FglTFRuntimeMipMap> Mips;
+				Asset->GetParser()->LoadBlobToMips(ImageData, Mips, TextureRequest.bSRGB, MaterialsConfig);
+				TexturesMips[TextureIndex] = AddSharedTexture(SharedTextureKey, MoveTemp(Mips));
+				NumTexturesDecoded.Increment();
+			});
+
+		if (Stats)
+		{
+			Stats->NumTexturesDecoded += NumTexturesDecoded.GetValue();
+		}
+
+		// failures are cached too
+		FScopeLock Lock(&(RuntimeOBJCacheData.MaterialsLock));
+		for (int32 TextureIndex = 0; TextureIndex < TextureRequests.Num(); TextureIndex++)
+		{
+			if (!RuntimeOBJCacheData.TexturesMips.Contains(TextureKeys[TextureIndex]))
+			{
+				RuntimeOBJCacheData.TexturesMips.Add(TextureKeys[TextureIndex], MoveTemp(TexturesMips[TextureIndex]));
+			}
+		}
+	}
+
+	/*
+	 * Returns the filled materials (from the cache when available). All of the textures of the
+	 * missing materials are decoded together before wiring them into the materials.
+	 */
+	TArray<TSharedRef<const FglTFRuntimeMaterial>> GetMaterials(UglTFRuntimeAsset* Asset, FglTFRuntimeOBJCacheData& RuntimeOBJCacheData, const TArray<FString>& MaterialNames, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FString& MaterialsConfigKey, FglTFRuntimeOBJLoadStats* Stats)
+	{
+		TArray<TSharedRef<const FglTFRuntimeMaterial>> Materials;
+		TArray<FglTFRuntimeOBJPendingMaterial> PendingMaterials;
+		TArray<int32> PendingMaterialsIndices;
+
+		FglTFRuntimeOBJScopeTimer Timer(Stats ? &Stats->FillMaterialsTime : nullptr);
+
+		{
+			FScopeLock Lock(&(RuntimeOBJCacheData.MaterialsLock));
+			for (const FString& MaterialName : MaterialNames)
+			{
+				if (const TSharedRef<const FglTFRuntimeMaterial>* CachedMaterial = RuntimeOBJCacheData.Materials.Find(MaterialName + "@" + MaterialsConfigKey))
+				{
+					Materials.Add(*CachedMaterial);
+					continue;
+				}
+
+				FglTFRuntimeOBJPendingMaterial& PendingMaterial = PendingMaterials.AddDefaulted_GetRef();
+				PendingMaterial.Name = MaterialName;
+				if (const int32* StartingLine = RuntimeOBJCacheData.MaterialFirstLines.Find(MaterialName))
+				{
+					FillMaterial(RuntimeOBJCacheData, *StartingLine, PendingMaterial);
+				}
+
+				PendingMaterialsIndices.Add(Materials.Num());
+				Materials.Add(PendingMaterial.Material);
+			}
+		}
+
+		if (PendingMaterials.Num() == 0)
+		{
+			return Materials;
+		}
+
+		DecodeTextures(Asset, RuntimeOBJCacheData, PendingMaterials, MaterialsConfig, MaterialsConfigKey, Stats);
+
+		FScopeLock Lock(&(RuntimeOBJCacheData.MaterialsLock));
+		for (int32 PendingIndex = 0; PendingIndex < PendingMaterials.Num(); PendingIndex++)
+		{
+			FglTFRuntimeOBJPendingMaterial& PendingMaterial = PendingMaterials[PendingIndex];
+			const FString MaterialKey = PendingMaterial.Name + "@" + MaterialsConfigKey;
+
+			// another thread could have completed the same material in the meantime
+			if (const TSharedRef<const FglTFRuntimeMaterial>* CachedMaterial = RuntimeOBJCacheData.Materials.Find(MaterialKey))
+			{
+				Materials[PendingMaterialsIndices[PendingIndex]] = *CachedMaterial;
+				continue;
+			}
+
+			ApplyMaterialTextures(PendingMaterial, RuntimeOBJCacheData.TexturesMips, MaterialsConfigKey);
+			RuntimeOBJCacheData.Materials.Add(MaterialKey, PendingMaterial.Material);
+		}
+
+		return Materials;
+	}
+
+	TArray<FString> GetObjectMaterialNames(const FglTFRuntimeOBJCacheData& RuntimeOBJCacheData, const FglTFRuntimeOBJObjectRange& ObjectRange)
+	{
+		const TArray<int32>& MaterialUseLines = RuntimeOBJCacheData.MaterialUseLines;
+
+		TArray<FString> MaterialNames;
+		FglTFRuntimeOBJTokens Line;
+		for (int32 MaterialUseIndex = Algo::LowerBound(MaterialUseLines, ObjectRange.FirstLine); MaterialUseIndex < MaterialUseLines.Num() && MaterialUseLines[MaterialUseIndex] < ObjectRange.LastLine; MaterialUseIndex++)
+		{
+			RuntimeOBJCacheData.GeometryLines.Tokenize(MaterialUseLines[MaterialUseIndex], Line);
+			MaterialNames.AddUnique(GetRemainingString(Line, 1));
+		}
+
+		return MaterialNames;
+	}
+
+	void BuildObjectMaterials(UglTFRuntimeAsset* Asset, FglTFRuntimeOBJCacheData& RuntimeOBJCacheData, const TArray<FString>& MaterialNames, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FString& MaterialsConfigKey, TMap<FString, UMaterialInterface*>& ObjectMaterials, FglTFRuntimeOBJLoadStats* Stats)
+	{
+		TArray<FString> MaterialNamesToBuild;
+		{
+			FScopeLock Lock(&(RuntimeOBJCacheData.MaterialsLock));
+			for (const FString& MaterialName : MaterialNames)
+			{
+				if (const TWeakObjectPtr<UMaterialInterface>* BuiltMaterial = RuntimeOBJCacheData.BuiltMaterials.Find(MaterialName + "@" + MaterialsConfigKey))
+				{
+					if (BuiltMaterial->IsValid())
+					{
+						ObjectMaterials.Add(MaterialName, BuiltMaterial->Get());
+						continue;
+					}
+				}
+
+				MaterialNamesToBuild.Add(MaterialName);
+			}
+		}
+
+		TArray<TPair<FString, TSharedRef<const FglTFRuntimeMaterial>>> MaterialsToBuild;
+		const TArray<TSharedRef<const FglTFRuntimeMaterial>> Materials = GetMaterials(Asset, RuntimeOBJCacheData, MaterialNamesToBuild, MaterialsConfig, MaterialsConfigKey, Stats);
+		for (int32 MaterialIndex = 0; MaterialIndex < MaterialNamesToBuild.Num(); MaterialIndex++)
+		{
+			MaterialsToBuild.Add(TPair<FString, TSharedRef<const FglTFRuntimeMaterial>>(MaterialNamesToBuild[MaterialIndex], Materials[MaterialIndex]));
+		}
+
+		if (MaterialsToBuild.Num() == 0)
+		{
+			return;
+		}
+
+		// all of the missing materials are built with a single game thread round trip (without holding any lock)
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_BuildMaterials);
+		FglTFRuntimeOBJScopeTimer Timer(Stats ? &Stats->BuildMaterialsTime : nullptr);
+
+		auto BuildMaterials = [&]()
+			{
+				SCOPE_CYCLE_COUNTER(STAT_glTFRuntimeOBJ_BuildMaterials);
+				for (const TPair<FString, TSharedRef<const FglTFRuntimeMaterial>>& Pair : MaterialsToBuild)
+				{
+					ObjectMaterials.Add(Pair.Key, Asset->GetParser()->BuildMaterial(-1, Pair.Key, Pair.Value.Get(), MaterialsConfig, false));
+				}
+			};
+
+		if (IsInGameThread())
+		{
+			BuildMaterials();
+		}
+		else
+		{
+			FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady(BuildMaterials, TStatId(), nullptr, ENamedThreads::GameThread);
+			FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+		}
+
+		FScopeLock Lock(&(RuntimeOBJCacheData.MaterialsLock));
+		for (const TPair<FString, TSharedRef<const FglTFRuntimeMaterial>>& Pair : MaterialsToBuild)
+		{
+			RuntimeOBJCacheData.BuiltMaterials.Add(Pair.Key + "@" + MaterialsConfigKey, ObjectMaterials.FindRef(Pair.Key));
+		}
+	}
+
+	/*
+	 * When BatchCallback is set, completed primitives are handed to it every BatchTriangles triangles
+	 * and RuntimeLOD only contains the last batch on return. Streamed objects are never cached.
+	 * Stats (if any) receive the timings of the stages executed by this call.
+	 * When SharedRuntimeLODs is set, it receives the object (as a single LOD chain) instead of RuntimeLOD.
+	 */
+	bool LoadObjectAsRuntimeLOD(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig, FglTFRuntimeOBJLoadStats* Stats = nullptr, const TFunction<void(FglTFRuntimeMeshLOD&)>& BatchCallback = nullptr, const int32 BatchTriangles = 0, FglTFRuntimeOBJSharedMeshLODs* SharedRuntimeLODs = nullptr)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_LoadObjectAsRuntimeLOD);
+
+		const bool bStreaming = BatchCallback && BatchTriangles > 0;
+		const bool bUseDiskCache = !OBJConfig.DiskCacheDirectory.IsEmpty() && !bStreaming;
+
+		// with the disk cache the geometry is parsed only on cache misses
+		TSharedPtr<FglTFRuntimeOBJCacheData> RuntimeOBJCacheData = glTFRuntimeOBJ::GetCacheData(Asset, !bUseDiskCache, Stats);
+		if (!RuntimeOBJCacheData)
+		{
+			return false;
+		}
+
+		const FString ObjectCacheKey = GetObjectCacheKey(ObjectName, OBJConfig);
+		const bool bCacheObject = OBJConfig.bCacheObjects && !bStreaming;
+		if (bCacheObject)
+		{
+			FReadScopeLock ReadLock(RuntimeOBJCacheData->ObjectsLock);
+			if (const FglTFRuntimeOBJSharedMeshLODs* CachedRuntimeLODs = RuntimeOBJCacheData->Objects.Find(ObjectCacheKey))
+			{
+				if (SharedRuntimeLODs)
+				{
+					*SharedRuntimeLODs = *CachedRuntimeLODs;
+				}
+				else
+				{
+					RuntimeLOD = (**CachedRuntimeLODs)[0];
+				}
+
+				if (Stats)
+				{
+					Stats->bFromMemoryCache = true;
+				}
+				return true;
+			}
+		}
+
+		// the built mesh is moved in the cache (or in SharedRuntimeLODs); by-value requests with caching enabled get a copy of the cached mesh
+		auto ShareRuntimeLOD = [&]()
+			{
+				if (!bCacheObject && !SharedRuntimeLODs)
+				{
+					return;
+				}
+
+				TSharedRef<TArray<FglTFRuntimeMeshLOD>, ESPMode::ThreadSafe> NewRuntimeLODs = MakeShared<TArray<FglTFRuntimeMeshLOD>, ESPMode::ThreadSafe>();
+				NewRuntimeLODs->Add(MoveTemp(RuntimeLOD));
+
+				if (bCacheObject)
+				{
+					FWriteScopeLock WriteLock(RuntimeOBJCacheData->ObjectsLock);
+					RuntimeOBJCacheData->Objects.Add(ObjectCacheKey, NewRuntimeLODs);
+				}
+
+				if (SharedRuntimeLODs)
+				{
+					*SharedRuntimeLODs = NewRuntimeLODs;
+				}
+				else
+				{
+					RuntimeLOD = (*NewRuntimeLODs)[0];
+				}
+			};
+
+		const FString MaterialsConfigKey = GetMaterialsConfigKey(MaterialsConfig);
+
+		FString DiskCacheFilename;
+		if (bUseDiskCache)
+		{
+			DiskCacheFilename = GetDiskCacheFilename(Asset, *RuntimeOBJCacheData, ObjectName, MaterialsConfig, OBJConfig);
+
+			TArray<FString> PrimitivesMaterials;
+			TArray<FString> MaterialLibraries;
+			bool bDiskCacheHit = false;
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_LoadFromDiskCache);
+				FglTFRuntimeOBJScopeTimer Timer(Stats ? &Stats->DiskCacheTime : nullptr);
+				bDiskCacheHit = LoadRuntimeLODFromDiskCache(DiskCacheFilename, RuntimeLOD, PrimitivesMaterials, MaterialLibraries);
+			}
+
+			if (bDiskCacheHit)
+			{
+				if (Stats)
+				{
+					Stats->bFromDiskCache = true;
+				}
+
+				{
+					FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+					LoadMaterialLibraries(Asset, *RuntimeOBJCacheData, MaterialLibraries, Stats);
+				}
+
+				TArray<FString> MaterialNames;
+				for (const FString& MaterialName : PrimitivesMaterials)
+				{
+					if (!MaterialName.IsEmpty())
+					{
+						MaterialNames.AddUnique(MaterialName);
+					}
+				}
+
+				TMap<FString, UMaterialInterface*> ObjectMaterials;
+				BuildObjectMaterials(Asset, *RuntimeOBJCacheData, MaterialNames, MaterialsConfig, MaterialsConfigKey, ObjectMaterials, Stats);
+
+				for (int32 PrimitiveIndex = 0; PrimitiveIndex < RuntimeLOD.Primitives.Num(); PrimitiveIndex++)
+				{
+					const FString& MaterialName = PrimitivesMaterials[PrimitiveIndex];
+					RuntimeLOD.Primitives[PrimitiveIndex].Material = MaterialName.IsEmpty() ? UMaterial::GetDefaultMaterial(MD_Surface) : ObjectMaterials.FindRef(MaterialName);
+				}
+
+				ShareRuntimeLOD();
+				return true;
+			}
+
+			RuntimeOBJCacheData = glTFRuntimeOBJ::GetCacheData(Asset, true, Stats);
+			if (!RuntimeOBJCacheData)
+			{
+				return false;
+			}
+		}
+
+		if (!RuntimeOBJCacheData->bValidAttributes)
+		{
+			return false;
+		}
+
+		const FglTFRuntimeOBJObjectRange* ObjectRange = RuntimeOBJCacheData->ObjectRanges.Find(ObjectName);
+		if (!ObjectRange)
+		{
+			return false;
+		}
+
+		const FglTFRuntimeOBJVectorPool& Vertices = RuntimeOBJCacheData->Vertices;
+		const FglTFRuntimeOBJVectorPool& Normals = RuntimeOBJCacheData->Normals;
+		const FglTFRuntimeOBJUVPool& UVs = RuntimeOBJCacheData->UVs;
+
+		int32 CurrentVertexCounter = ObjectRange->VertexBase;
+		int32 CurrentUVCounter = ObjectRange->UVBase;
+		int32 CurrentNormalCounter = ObjectRange->NormalBase;
+
+		TMap<FString, UMaterialInterface*> ObjectMaterials;
+		BuildObjectMaterials(Asset, *RuntimeOBJCacheData, GetObjectMaterialNames(*RuntimeOBJCacheData, *ObjectRange), MaterialsConfig, MaterialsConfigKey, ObjectMaterials, Stats);
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_BuildObject);
+		SCOPE_CYCLE_COUNTER(STAT_glTFRuntimeOBJ_BuildObject);
+		const double BuildStartTime = FPlatformTime::Seconds();
+
+		FglTFRuntimeOBJTokens Line;
+
+		TArray<TStaticArray<TPair<uint32, bool>, 3>> Indices;
+		// smoothing group of each triangle in Indices
+		TArray<uint32> SmoothingGroups;
+		uint32 CurrentSmoothingGroup = 0;
+
+		// corners of the primitives not fixed yet (they are fixed in parallel)
+		TArray<TArray<TStaticArray<TPair<uint32, bool>, 3>>> PendingIndices;
+		TArray<TArray<uint32>> PendingSmoothingGroups;
+
+		// triangulation scratch buffers
+		TArray<TStaticArray<TPair<uint32, bool>, 3>> PolygonIndices;
+#if ENGINE_MAJOR_VERSION >= 5
+		TArray<FVector> PolygonVertices;
+		TArray<UE::Geometry::FIndex3i> Triangles;
+#else
+		TArray<FVector3<float>> PolygonVertices;
+		TArray<FIndex3i> Triangles;
+#endif
+
+		RuntimeLOD.Empty();
+
+		FglTFRuntimePrimitive Primitive;
+		Primitive.Material = UMaterial::GetDefaultMaterial(MD_Surface);
+
+		int32 NumBatchTriangles = 0;
+
+		auto FixPendingPrimitives = [&]()
+			{
+				FglTFRuntimeOBJScopeTimer Timer(Stats ? &Stats->FixPrimitivesTime : nullptr);
+				const int32 FirstPending = RuntimeLOD.Primitives.Num() - PendingIndices.Num();
+				ParallelFor(PendingIndices.Num(), [&](const int32 PendingIndex)
+					{
+						glTFRuntimeOBJ::FixPrimitive(RuntimeLOD.Primitives[FirstPending + PendingIndex], PendingIndices[PendingIndex], PendingSmoothingGroups[PendingIndex], *RuntimeOBJCacheData, OBJConfig);
+					});
+				PendingIndices.Empty();
+				PendingSmoothingGroups.Empty();
+			};
+
+		auto AddPrimitive = [&]()
+			{
+				NumBatchTriangles += Indices.Num() / 3;
+				if (Stats)
+				{
+					Stats->NumVerticesBeforeDeduplication += Indices.Num();
+				}
+				RuntimeLOD.Primitives.Add(MoveTemp(Primitive));
+				PendingIndices.Add(MoveTemp(Indices));
+				PendingSmoothingGroups.Add(MoveTemp(SmoothingGroups));
+
+				if (bStreaming && NumBatchTriangles >= BatchTriangles)
+				{
+					FixPendingPrimitives();
+					if (MaterialsConfig.bMergeSectionsByMaterial)
+					{
+						Asset->GetParser()->MergePrimitivesByMaterial(RuntimeLOD.Primitives);
+					}
+					BatchCallback(RuntimeLOD);
+					RuntimeLOD.Empty();
+					NumBatchTriangles = 0;
+				}
+			};
 
-			// mtllib
-			if (Line[0] == "mtllib")
+		auto GetFaceIndex = [](int32 Value, const int32 NumVertices, const int32 NumTotalVertices, const int32 EntryBase) -> uint32
 			{
-				const FString MaterialFilename = GetRemainingString(Line, 1);
-				TArray64<uint8> MaterialBlob;
-				if (Asset->GetParser()->LoadPathToBlob(MaterialFilename, MaterialBlob))
+				if (Value > 0)
 				{
-					FillLinesFromBlob(MaterialBlob, RuntimeOBJCacheData->MaterialLines);
+					Value += EntryBase - 1;
+					if (Value < NumTotalVertices)
+					{
+						return Value;
+					}
 				}
-				// fallback to filename.mtl
-				else
+				else if (Value < 0)
 				{
-					const FString MaterialFallbackFilename = Asset->GetParser()->GetBaseFilename() + ".mtl";
-					if (Asset->GetParser()->LoadPathToBlob(MaterialFallbackFilename, MaterialBlob))
+					if (NumVertices >= FMath::Abs(Value))
+					{
+						return NumVertices + Value;
+					}
+					// probably not a good idea but most obj exporters are very lazy...
+					else if (NumTotalVertices >= FMath::Abs(Value))
 					{
-						FillLinesFromBlob(MaterialBlob, RuntimeOBJCacheData->MaterialLines);
+						return NumTotalVertices + Value;
 					}
 				}
-			}
-		}
-
-		RuntimeOBJCacheData->bValid = true;
+				return 0;
+			};
 
-		return RuntimeOBJCacheData;
-	}
+		auto GetFaceVertexIndex = [&](const FAnsiStringView& Token) -> TStaticArray<TPair<uint32, bool>, 3>
+			{
+				int32 Values[3];
+				bool bHasValues[3];
+				glTFRuntimeOBJ::ParseFaceVertex(Token, Values, bHasValues);
+
+				TStaticArray<TPair<uint32, bool>, 3> Index;
+				Index[0] = TPair<uint32, bool>(GetFaceIndex(Values[0], CurrentVertexCounter, Vertices.Num(), ObjectRange->EntryVertexBase), true);
+				Index[1] = TPair<uint32, bool>(bHasValues[1] ? GetFaceIndex(Values[1], CurrentUVCounter, UVs.Num(), ObjectRange->EntryUVBase) : 0, bHasValues[1]);
+				Index[2] = TPair<uint32, bool>(bHasValues[2] ? GetFaceIndex(Values[2], CurrentNormalCounter, Normals.Num(), ObjectRange->EntryNormalBase) : 0, bHasValues[2]);
+				return Index;
+			};
 
-	void FixPrimitive(FglTFRuntimePrimitive& Primitive, const TArray<TStaticArray<TPair<uint32, bool>, 3>> Indices, const TArray<FVector>& Vertices, const TArray<FVector2D>& UVs, const TArray<FVector>& Normals)
-	{
-		if (UVs.Num() > 0)
+		// step 2, build primitives
+		for (int32 LineIndex = ObjectRange->FirstLine; LineIndex < ObjectRange->LastLine; LineIndex++)
 		{
-			Primitive.UVs.AddDefaulted();
-		}
+			RuntimeOBJCacheData->GeometryLines.Tokenize(LineIndex, Line);
 
-		for (int32 Index = 0; Index < Indices.Num(); Index++)
-		{
-			const uint32 VertexIndex = Indices[Index][0].Key;
-			const bool bHasVertex = Indices[Index][0].Value;
-			if (!bHasVertex)
+			if (IsToken(Line[0], "v"))
 			{
+				CurrentVertexCounter++;
 				continue;
 			}
 
-			if (!Vertices.IsValidIndex(VertexIndex))
+			if (IsToken(Line[0], "vt"))
 			{
+				CurrentUVCounter++;
 				continue;
 			}
 
-			const int32 PositionIndex = Primitive.Positions.Add(Vertices[VertexIndex]);
-
-			if (UVs.Num() > 0)
+			if (IsToken(Line[0], "vn"))
 			{
-				const uint32 UVIndex = Indices[Index][1].Key;
-				const bool bHasUV = Indices[Index][1].Value;
-
-				if (bHasUV && UVs.IsValidIndex(UVIndex))
-				{
-					Primitive.UVs[0].Add(UVs[UVIndex]);
-				}
-				else
-				{
-					Primitive.UVs[0].Add(FVector2D::ZeroVector);
-				}
+				CurrentNormalCounter++;
+				continue;
 			}
 
-			if (Normals.Num() > 0)
+			// smoothing group ("s off" and "s 0" disable smoothing)
+			if (IsToken(Line[0], "s"))
 			{
-				const uint32 NormalIndex = Indices[Index][2].Key;
-				const bool bHasNormal = Indices[Index][2].Value;
+				CurrentSmoothingGroup = Line.Num() > 1 ? static_cast<uint32>(FMath::Max(glTFRuntimeOBJ::TokenToInt(Line[1]), 0)) : 0;
+				continue;
+			}
 
-				if (bHasNormal && Normals.IsValidIndex(NormalIndex))
+			// group
+			if (IsToken(Line[0], "g"))
+			{
+				if (Indices.Num() > 0)
 				{
-					Primitive.Normals.Add(Normals[NormalIndex]);
+					AddPrimitive();
 				}
-				else
+				// a usemtl could be already been parsed
+				else if (!Primitive.Material)
 				{
-					Primitive.Normals.Add(FVector::ZAxisVector);
+					Primitive = FglTFRuntimePrimitive();
+					Primitive.Material = UMaterial::GetDefaultMaterial(MD_Surface);
 				}
+				Indices.Empty();
+				Primitive.MaterialName = glTFRuntimeOBJ::GetRemainingString(Line, 1);
+				continue;
 			}
 
-			Primitive.Indices.Add(PositionIndex);
-		}
-	}
-
-	void FillMaterial(UglTFRuntimeAsset* Asset, const FString& MaterialName, FglTFRuntimeMaterial& Material, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
-	{
-		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
-
-		TSharedPtr<FglTFRuntimeOBJCacheData> RuntimeOBJCacheData = GetCacheData(Asset);
-
-		int32 StartingLine = -1;
-
-		// search for material
-		for (int32 LineIndex = 0; LineIndex < RuntimeOBJCacheData->MaterialLines.Num(); LineIndex++)
-		{
-			const TArray<FString>& Line = RuntimeOBJCacheData->MaterialLines[LineIndex];
-
-			if (Line[0] == "newmtl")
+			// face
+			if (IsToken(Line[0], "f"))
 			{
-				if (GetRemainingString(Line, 1) == MaterialName)
+				if (Line.Num() < 4)
 				{
-					StartingLine = LineIndex + 1;
-					break;
+					return false;
 				}
-			}
-		}
-
-		if (StartingLine < 0)
-		{
-			return;
-		}
-
-		Material.MaterialType = EglTFRuntimeMaterialType::TwoSided;
-
-		// fill material
-		for (int32 LineIndex = StartingLine; LineIndex < RuntimeOBJCacheData->MaterialLines.Num(); LineIndex++)
-		{
-			const TArray<FString>& Line = RuntimeOBJCacheData->MaterialLines[LineIndex];
-			if (Line[0] == "newmtl")
-			{
-				break;
-			}
 
-			if (Line[0] == "Kd")
-			{
-				if (Line.Num() >= 4)
-				{
-					Material.bHasBaseColorFactor = true;
-					Material.BaseColorFactor.R = FCString::Atod(*(Line[1]));
-					Material.BaseColorFactor.G = FCString::Atod(*(Line[2]));
-					Material.BaseColorFactor.B = FCString::Atod(*(Line[3]));
-				}
-				continue;
-			}
+				const int32 NumVertices = Line.Num() - 1;
 
-			if (Line[0] == "d")
-			{
-				if (Line.Num() >= 2)
+				// complex polygons ?
+				if (NumVertices > 3)
 				{
-					Material.BaseColorFactor.A = FCString::Atod(*(Line[1]));
-					if (Material.BaseColorFactor.A < 1)
+					PolygonIndices.Reset();
+					for (int32 FaceVertexIndex = 0; FaceVertexIndex < NumVertices; FaceVertexIndex++)
 					{
-						Material.bTranslucent = true;
-						Material.MaterialType = EglTFRuntimeMaterialType::TwoSidedTranslucent;
+						PolygonIndices.Add(GetFaceVertexIndex(Line[FaceVertexIndex + 1]));
 					}
-				}
-				continue;
-			}
 
-			if (Line[0] == "Tr")
-			{
-				if (Line.Num() >= 2)
+					glTFRuntimeOBJ::TriangulatePolygon(Vertices, PolygonIndices, Indices, PolygonVertices, Triangles);
+				}
+				else
 				{
-					Material.BaseColorFactor.A = 1 - FCString::Atod(*(Line[1]));
-					if (Material.BaseColorFactor.A < 1)
+					for (int32 FaceVertexIndex = 0; FaceVertexIndex < 3; FaceVertexIndex++)
 					{
-						Material.bTranslucent = true;
-						Material.MaterialType = EglTFRuntimeMaterialType::TwoSidedTranslucent;
+						Indices.Add(GetFaceVertexIndex(Line[FaceVertexIndex + 1]));
 					}
 				}
-				continue;
-			}
 
-			if (Line[0] == "Ns")
-			{
-				if (Line.Num() >= 2)
+				while (SmoothingGroups.Num() < Indices.Num() / 3)
 				{
-					Material.BaseSpecularFactor = FCString::Atod(*(Line[1])) / 1000;
+					SmoothingGroups.Add(CurrentSmoothingGroup);
 				}
-				continue;
-			}
 
-			if (Line[0] == "map_Kd")
-			{
-				const FString Filename = GetRemainingString(Line, 1);
-				TArray64<uint8> ImageData;
-				if (Asset->GetParser()->LoadPathToBlob(Filename, ImageData))
+				// split huge sections, so batches never grow over BatchTriangles
+				if (bStreaming && NumBatchTriangles + Indices.Num() / 3 >= BatchTriangles)
 				{
-					Asset->GetParser()->LoadBlobToMips(ImageData, Material.BaseColorTextureMips, true, MaterialsConfig);
+					UMaterialInterface* Material = Primitive.Material;
+					const FString MaterialName = Primitive.MaterialName;
+					AddPrimitive();
+					Indices.Reset();
+					Primitive = FglTFRuntimePrimitive();
+					Primitive.Material = Material;
+					Primitive.MaterialName = MaterialName;
 				}
 				continue;
 			}
 
-			if (Line[0] == "map_Bump")
+			// material
+			if (IsToken(Line[0], "usemtl"))
 			{
-				const FString Filename = GetRemainingString(Line, 1);
-				TArray64<uint8> ImageData;
-				if (Asset->GetParser()->LoadPathToBlob(Filename, ImageData))
+				if (Indices.Num() > 0)
 				{
-					Asset->GetParser()->LoadBlobToMips(ImageData, Material.NormalTextureMips, false, MaterialsConfig);
+					AddPrimitive();
 				}
+				Indices.Empty();
+				Primitive = FglTFRuntimePrimitive();
+				Primitive.MaterialName = glTFRuntimeOBJ::GetRemainingString(Line, 1);
+				Primitive.Material = ObjectMaterials.FindRef(Primitive.MaterialName);
+
 				continue;
 			}
 		}
-	}
 
-	bool LoadObjectAsRuntimeLOD(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
-	{
-		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
-
-		TSharedPtr<FglTFRuntimeOBJCacheData> RuntimeOBJCacheData = glTFRuntimeOBJ::GetCacheData(Asset);
-		if (!RuntimeOBJCacheData)
+		if (Indices.Num() > 0)
 		{
-			return false;
+			AddPrimitive();
 		}
 
-		if (RuntimeOBJCacheData->Objects.Contains(ObjectName))
+		FixPendingPrimitives();
+
+		if (MaterialsConfig.bMergeSectionsByMaterial)
 		{
-			RuntimeLOD = RuntimeOBJCacheData->Objects[ObjectName];
-			return true;
+			TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_MergePrimitivesByMaterial);
+			Asset->GetParser()->MergePrimitivesByMaterial(RuntimeLOD.Primitives);
 		}
 
-		int32 StartingLine = -1;
+		if (Stats)
+		{
+			// FixPrimitive has its own counter
+			Stats->BuildTime = static_cast<float>(FPlatformTime::Seconds() - BuildStartTime) - Stats->FixPrimitivesTime;
+		}
 
-		if (!ObjectName.IsEmpty())
+		if (bUseDiskCache)
 		{
-			for (int32 LineIndex = 0; LineIndex < RuntimeOBJCacheData->GeometryLines.Num(); LineIndex++)
+			// materials are stored by their usemtl name and rebuilt on load
+			TMap<UMaterialInterface*, FString> MaterialsNames;
+			for (const TPair<FString, UMaterialInterface*>& Pair : ObjectMaterials)
 			{
-				const TArray<FString>& Line = RuntimeOBJCacheData->GeometryLines[LineIndex];
-
-				if (Line[0] == "o")
+				if (Pair.Value)
 				{
-					if (glTFRuntimeOBJ::GetRemainingString(Line, 1) == ObjectName)
-					{
-						StartingLine = LineIndex + 1;
-						break;
-					}
+					MaterialsNames.Add(Pair.Value, Pair.Key);
 				}
 			}
-		}
-		else
-		{
-			// empty name, get the first unammed object
-			StartingLine = 0;
+
+			TArray<FString> PrimitivesMaterials;
+			for (const FglTFRuntimePrimitive& CurrentPrimitive : RuntimeLOD.Primitives)
+			{
+				PrimitivesMaterials.Add(MaterialsNames.FindRef(CurrentPrimitive.Material));
+			}
+
+			TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_SaveToDiskCache);
+			FglTFRuntimeOBJScopeTimer Timer(Stats ? &Stats->DiskCacheTime : nullptr);
+			SaveRuntimeLODToDiskCache(DiskCacheFilename, RuntimeLOD, PrimitivesMaterials, RuntimeOBJCacheData->MaterialLibraries);
 		}
 
-		if (StartingLine < 0)
+		if (!bStreaming)
 		{
-			return false;
+			ShareRuntimeLOD();
 		}
 
-		TArray<FVector> Vertices;
-		TArray<FVector> Normals;
-		TArray<FVector2D> UVs;
+		return true;
+	}
 
-		int32 CurrentVertexCounter = 0;
-		int32 CurrentUVCounter = 0;
-		int32 CurrentNormalCounter = 0;
+	/*
+	 * LOD0 followed by the generated LODs, shared with the asset memory cache (cache hits never copy the meshes).
+	 * The chain is cached under the LOD0 key too (LOD0 hits only read the first mesh), so a single LOD0 stays resident.
+	 */
+	bool LoadObjectAsSharedRuntimeLODs(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeOBJSharedMeshLODs& RuntimeLODs, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+	{
+		FglTFRuntimeMeshLOD RuntimeLOD;
 
-		// step 1, gather vertices, normals and uvs
-		for (int32 LineIndex = 0; LineIndex < RuntimeOBJCacheData->GeometryLines.Num(); LineIndex++)
+		if (OBJConfig.NumGeneratedLODs <= 0)
 		{
-			const TArray<FString>& Line = RuntimeOBJCacheData->GeometryLines[LineIndex];
+			if (!LoadObjectAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig, OBJConfig, nullptr, nullptr, 0, &RuntimeLODs))
+			{
+				return false;
+			}
 
-			// vertex
-			if (Line[0] == "v")
+			// LOD0 of a cached chain, the caller gets its own single LOD array
+			if (RuntimeLODs->Num() > 1)
 			{
-				if (Line.Num() < 4)
-				{
-					return false;
-				}
+				TSharedRef<TArray<FglTFRuntimeMeshLOD>, ESPMode::ThreadSafe> LOD0 = MakeShared<TArray<FglTFRuntimeMeshLOD>, ESPMode::ThreadSafe>();
+				LOD0->Add((*RuntimeLODs)[0]);
+				RuntimeLODs = LOD0;
+			}
+			return true;
+		}
+
+		TSharedPtr<FglTFRuntimeOBJCacheData> RuntimeOBJCacheData = GetCacheData(Asset, false);
+		if (!RuntimeOBJCacheData)
+		{
+			return false;
+		}
 
-				FVector Vertex = FVector(FCString::Atod(*(Line[1])), FCString::Atod(*(Line[2])), FCString::Atod(*(Line[3])));
-				Vertices.Add(Asset->GetParser()->TransformPosition(Vertex));
+		const FString ObjectCacheKey = GetObjectCacheKey(ObjectName, OBJConfig);
+		const FString LODsCacheKey = FString::Printf(TEXT("%s#%d:%g"), *ObjectCacheKey, OBJConfig.NumGeneratedLODs, OBJConfig.LODTrianglesRatio);
 
-				if (LineIndex < StartingLine)
-				{
-					CurrentVertexCounter++;
-				}
-				continue;
+		if (OBJConfig.bCacheObjects)
+		{
+			FReadScopeLock ReadLock(RuntimeOBJCacheData->ObjectsLock);
+			if (const FglTFRuntimeOBJSharedMeshLODs* CachedRuntimeLODs = RuntimeOBJCacheData->Objects.Find(LODsCacheKey))
+			{
+				RuntimeLODs = *CachedRuntimeLODs;
+				return true;
 			}
+		}
 
-			// uv
-			if (Line[0] == "vt")
+		TSharedRef<TArray<FglTFRuntimeMeshLOD>, ESPMode::ThreadSafe> NewRuntimeLODs = MakeShared<TArray<FglTFRuntimeMeshLOD>, ESPMode::ThreadSafe>();
+
+		if (OBJConfig.bCacheObjects)
+		{
+			FWriteScopeLock WriteLock(RuntimeOBJCacheData->ObjectsLock);
+			if (const FglTFRuntimeOBJSharedMeshLODs* CachedRuntimeLODs = RuntimeOBJCacheData->Objects.Find(ObjectCacheKey))
 			{
-				if (Line.Num() < 3)
+				if ((*CachedRuntimeLODs)->Num() == 1 && CachedRuntimeLODs->IsUnique())
 				{
-					return false;
+					// nobody else references the cached LOD0 (and nobody can while the lock is held), so it is moved in the chain;
+					// until the chain is cached, LOD0 requests are misses
+					NewRuntimeLODs->Add(MoveTemp(const_cast<TArray<FglTFRuntimeMeshLOD>&>(**CachedRuntimeLODs)[0]));
+					RuntimeOBJCacheData->Objects.Remove(ObjectCacheKey);
 				}
-
-				FVector2D UV = FVector2D(FCString::Atod(*(Line[1])), 1 - FCString::Atod(*(Line[2])));
-				UVs.Add(UV);
-
-				if (LineIndex < StartingLine)
+				else
 				{
-					CurrentUVCounter++;
+					// still referenced by callers, or part of a chain with different LODs settings
+					NewRuntimeLODs->Add((**CachedRuntimeLODs)[0]);
 				}
-				continue;
 			}
+		}
 
-			// normal
-			if (Line[0] == "vn")
+		if (NewRuntimeLODs->Num() == 0)
+		{
+			FglTFRuntimeOBJConfig LOD0Config = OBJConfig;
+			LOD0Config.bCacheObjects = false;
+			if (!LoadObjectAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig, LOD0Config))
 			{
-				if (Line.Num() < 4)
-				{
-					return false;
-				}
-
-				FVector Normal = FVector(FCString::Atod(*(Line[1])), FCString::Atod(*(Line[2])), FCString::Atod(*(Line[3])));
-				Normals.Add(Asset->GetParser()->TransformVector(Normal));
-
-				if (LineIndex < StartingLine)
-				{
-					CurrentNormalCounter++;
-				}
-				continue;
+				return false;
 			}
+			NewRuntimeLODs->Add(MoveTemp(RuntimeLOD));
 		}
 
-		TArray<TStaticArray<TPair<uint32, bool>, 3>> Indices;
+		GenerateLODs(*NewRuntimeLODs, OBJConfig.NumGeneratedLODs, OBJConfig.LODTrianglesRatio);
 
-		RuntimeLOD.Empty();
+		if (OBJConfig.bCacheObjects)
+		{
+			FWriteScopeLock WriteLock(RuntimeOBJCacheData->ObjectsLock);
+			RuntimeOBJCacheData->Objects.Add(LODsCacheKey, NewRuntimeLODs);
+			RuntimeOBJCacheData->Objects.Add(ObjectCacheKey, NewRuntimeLODs);
+		}
 
-		FglTFRuntimePrimitive Primitive;
-		Primitive.Material = UMaterial::GetDefaultMaterial(MD_Surface);
+		RuntimeLODs = NewRuntimeLODs;
+		return true;
+	}
 
-		auto GetFaceIndex = [](const FString& Part, const int32 NumVertices, const int32 NumTotalVertices) -> uint32
+	bool LoadObjectAsRuntimeLODs(UglTFRuntimeAsset* Asset, const FString& ObjectName, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+	{
+		RuntimeLODs.Empty();
+
+		if (OBJConfig.bCacheObjects)
+		{
+			FglTFRuntimeOBJSharedMeshLODs SharedRuntimeLODs;
+			if (!LoadObjectAsSharedRuntimeLODs(Asset, ObjectName, SharedRuntimeLODs, MaterialsConfig, OBJConfig))
 			{
-				int32 Value = FCString::Atoi(*Part);
-				if (Value > 0)
-				{
-					Value--;
-					if (Value < NumTotalVertices)
-					{
-						return Value;
-					}
-				}
-				else if (Value < 0)
-				{
-					if (NumVertices >= FMath::Abs(Value))
-					{
-						return NumVertices + Value;
-					}
-					// probably not a good idea but most obj exporters are very lazy...
-					else if (NumTotalVertices >= FMath::Abs(Value))
-					{
-						return NumTotalVertices + Value;
-					}
-				}
-				return 0;
-			};
+				return false;
+			}
+
+			RuntimeLODs = *SharedRuntimeLODs;
+			return true;
+		}
+
+		FglTFRuntimeMeshLOD RuntimeLOD;
+		if (!LoadObjectAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig, OBJConfig))
+		{
+			return false;
+		}
+
+		RuntimeLODs.Add(MoveTemp(RuntimeLOD));
+		GenerateLODs(RuntimeLODs, OBJConfig.NumGeneratedLODs, OBJConfig.LODTrianglesRatio);
+		return true;
+	}
+
+	bool LoadObjectAsRuntimeLODWithStats(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeMeshLOD& RuntimeLOD, FglTFRuntimeOBJLoadStats& Stats, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+	{
+		Stats = FglTFRuntimeOBJLoadStats();
 
-		
+		const double StartTime = FPlatformTime::Seconds();
+		const bool bSuccess = LoadObjectAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig, OBJConfig, &Stats);
+		Stats.TotalTime = static_cast<float>(FPlatformTime::Seconds() - StartTime);
 
-		// step 2, build primitives
-		for (int32 LineIndex = StartingLine; LineIndex < RuntimeOBJCacheData->GeometryLines.Num(); LineIndex++)
+		if (TSharedPtr<FglTFRuntimeOBJCacheData> RuntimeOBJCacheData = GetCacheData(Asset, false))
 		{
-			const TArray<FString>& Line = RuntimeOBJCacheData->GeometryLines[LineIndex];
-
-			if (Line[0] == "v")
+			Stats.BytesRead = RuntimeOBJCacheData->GeometryLines.Size;
+			Stats.bGeometryParsed = RuntimeOBJCacheData->bValid;
+			if (Stats.bGeometryParsed)
 			{
-				CurrentVertexCounter++;
-				continue;
+				Stats.NumLines = RuntimeOBJCacheData->GeometryLines.Num();
+				Stats.NumSourceVertices = RuntimeOBJCacheData->Vertices.Num();
+				Stats.NumSourceUVs = RuntimeOBJCacheData->UVs.Num();
+				Stats.NumSourceNormals = RuntimeOBJCacheData->Normals.Num();
 			}
+		}
 
-			if (Line[0] == "vt")
-			{
-				CurrentUVCounter++;
-				continue;
-			}
+		TSet<UMaterialInterface*> Materials;
+		for (const FglTFRuntimePrimitive& Primitive : RuntimeLOD.Primitives)
+		{
+			Stats.NumVertices += Primitive.Positions.Num();
+			Stats.NumTriangles += Primitive.Indices.Num() / 3;
+			Materials.Add(Primitive.Material);
+		}
+		Stats.NumPrimitives = RuntimeLOD.Primitives.Num();
+		Stats.NumMaterials = Materials.Num();
+
+		return bSuccess;
+	}
+
+	/*
+	 * Appends the "o" lines of [Start, End) to Objects. Lines are skipped with memchr,
+	 * only the ones starting with 'o' are tokenized.
+	 * As in FillLinesFromBlob, both '\r' and '\n' terminate a line (files can mix them).
+	 */
+	void ScanObjectLines(const uint8* Data, const int64 Start, const int64 End, TArray<FglTFRuntimeOBJObjectInfo>& Objects)
+	{
+		FglTFRuntimeOBJTokens Line;
 
-			if (Line[0] == "vn")
+		int64 Cursor = Start;
+		while (Cursor < End)
+		{
+			// skip indentation and empty lines
+			while (Cursor < End && (Data[Cursor] == ' ' || Data[Cursor] == '\t' || Data[Cursor] == '\r' || Data[Cursor] == '\n'))
 			{
-				CurrentNormalCounter++;
-				continue;
+				Cursor++;
 			}
 
-			// end of object?
-			if (Line[0] == "o" && Indices.Num() > 0)
+			if (Cursor >= End)
 			{
 				break;
 			}
 
-			// group
-			if (Line[0] == "g")
+			const uint8* LineFeed = static_cast<const uint8*>(memchr(Data + Cursor, '\n', End - Cursor));
+			int64 LineEnd = LineFeed ? LineFeed - Data : End;
+			if (const uint8* CarriageReturn = static_cast<const uint8*>(memchr(Data + Cursor, '\r', LineEnd - Cursor)))
 			{
-				if (Indices.Num() > 0)
-				{
-					glTFRuntimeOBJ::FixPrimitive(Primitive, Indices, Vertices, UVs, Normals);
-					RuntimeLOD.Primitives.Add(MoveTemp(Primitive));
-				}
-				// a usemtl could be already been parsed
-				else if (!Primitive.Material)
-				{
-					Primitive = FglTFRuntimePrimitive();
-					Primitive.Material = UMaterial::GetDefaultMaterial(MD_Surface);
-				}
-				Indices.Empty();
-				Primitive.MaterialName = glTFRuntimeOBJ::GetRemainingString(Line, 1);
-				continue;
+				LineEnd = CarriageReturn - Data;
 			}
 
-			// face
-			if (Line[0] == "f")
+			if (Data[Cursor] == 'o' || Data[Cursor] == 'O')
 			{
-				if (Line.Num() < 4)
+				int64 Length = LineEnd - Cursor;
+				while (Length > 0 && (Data[Cursor + Length - 1] == ' ' || Data[Cursor + Length - 1] == '\t'))
 				{
-					return false;
+					Length--;
 				}
 
-				const int32 NumVertices = Line.Num() - 1;
-
-				// complex polygons ?
-				if (NumVertices > 3)
+				FglTFRuntimeOBJLines::Tokenize(Data, { Cursor, static_cast<int32>(Length) }, Line);
+				if (IsToken(Line[0], "o"))
 				{
-#if ENGINE_MAJOR_VERSION >= 5
-					TArray<FVector> PolygonVertices;
-#else
-					TArray<FVector3<float>> PolygonVertices;
-#endif
-					TArray<TStaticArray<TPair<uint32, bool>, 3>> PolygonIndices;
-					for (int32 FaceVertexIndex = 0; FaceVertexIndex < NumVertices; FaceVertexIndex++)
-					{
-						TArray<FString> FaceVertexParts;
-						Line[FaceVertexIndex + 1].ParseIntoArray(FaceVertexParts, TEXT("/"), false);
+					FglTFRuntimeOBJObjectInfo ObjectInfo;
+					ObjectInfo.Name = GetRemainingString(Line, 1);
+					ObjectInfo.Offset = Cursor;
+					Objects.Add(MoveTemp(ObjectInfo));
+				}
+			}
 
-						TStaticArray<TPair<uint32, bool>, 3> Index;
+			Cursor = LineEnd + 1;
+		}
+	}
 
-						Index[0] = TPair<uint32, bool>(GetFaceIndex(FaceVertexParts[0], CurrentVertexCounter, Vertices.Num()), true);
+	/*
+	 * Lists the objects without parsing the geometry (and without loading the material libraries):
+	 * only the geometry source is resolved and scanned in parallel for "o" lines.
+	 */
+	TArray<FglTFRuntimeOBJObjectInfo> GetObjectInfos(UglTFRuntimeAsset* Asset)
+	{
+		TArray<FglTFRuntimeOBJObjectInfo> ObjectInfos;
 
-						PolygonVertices.Add(Vertices[Index[0].Key]);
+		if (!Asset)
+		{
+			return ObjectInfos;
+		}
 
-						Index[1] = TPair<uint32, bool>(0, false);
-						Index[2] = TPair<uint32, bool>(0, false);
+		TSharedPtr<FglTFRuntimeOBJCacheData> RuntimeOBJCacheData = glTFRuntimeOBJ::GetCacheData(Asset, false);
+		if (!RuntimeOBJCacheData)
+		{
+			return ObjectInfos;
+		}
 
-						if (FaceVertexParts.Num() > 1 && !FaceVertexParts[1].IsEmpty())
-						{
-							Index[1] = TPair<uint32, bool>(GetFaceIndex(FaceVertexParts[1], CurrentUVCounter, UVs.Num()), true);
-						}
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_GetObjectInfos);
 
-						if (FaceVertexParts.Num() > 2 && !FaceVertexParts[2].IsEmpty())
-						{
-							Index[2] = TPair<uint32, bool>(GetFaceIndex(FaceVertexParts[2], CurrentNormalCounter, Normals.Num()), true);
-						}
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
 
-						PolygonIndices.Add(Index);
-					}
+		if (!RuntimeOBJCacheData->ObjectInfos.IsSet())
+		{
+			const uint8* Data = RuntimeOBJCacheData->GeometryLines.Data;
+			const int64 Size = RuntimeOBJCacheData->GeometryLines.Size;
 
-#if ENGINE_MAJOR_VERSION >= 5
-					TArray<UE::Geometry::FIndex3i> Triangles;
-#else
-					TArray<FIndex3i> Triangles;
-#endif
-					PolygonTriangulation::TriangulateSimplePolygon(PolygonVertices, Triangles);
+			const TArray<FglTFRuntimeOBJEntry>& Entries = RuntimeOBJCacheData->Entries;
+			const bool bMultipleEntries = Entries.Num() > 1;
 
-#if ENGINE_MAJOR_VERSION >= 5
-					for (const UE::Geometry::FIndex3i& Triangle : Triangles)
-#else
-					for (const FIndex3i& Triangle : Triangles)
-#endif
-					{
-						Indices.Add(PolygonIndices[Triangle.A]);
-						Indices.Add(PolygonIndices[Triangle.C]);
-						Indices.Add(PolygonIndices[Triangle.B]);
-					}
-				}
-				else
+			// chunks never cross archive entries
+			TArray<FglTFRuntimeOBJChunk> Chunks;
+			if (bMultipleEntries)
+			{
+				for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
 				{
-					for (int32 FaceVertexIndex = 0; FaceVertexIndex < 3; FaceVertexIndex++)
+					TArray<FglTFRuntimeOBJChunk> EntryChunks;
+					SplitBlobInChunks(Data + Entries[EntryIndex].Offset, Entries[EntryIndex].Size, EntryChunks);
+					for (FglTFRuntimeOBJChunk& Chunk : EntryChunks)
 					{
-						TArray<FString> FaceVertexParts;
-						Line[FaceVertexIndex + 1].ParseIntoArray(FaceVertexParts, TEXT("/"), false);
-
-						TStaticArray<TPair<uint32, bool>, 3> Index;
-
-						Index[0] = TPair<uint32, bool>(GetFaceIndex(FaceVertexParts[0], CurrentVertexCounter, Vertices.Num()), true);
-						Index[1] = TPair<uint32, bool>(0, false);
-						Index[2] = TPair<uint32, bool>(0, false);
-
-						if (FaceVertexParts.Num() > 1 && !FaceVertexParts[1].IsEmpty())
-						{
-							Index[1] = TPair<uint32, bool>(GetFaceIndex(FaceVertexParts[1], CurrentUVCounter, UVs.Num()), true);
-						}
-
-						if (FaceVertexParts.Num() > 2 && !FaceVertexParts[2].IsEmpty())
-						{
-							Index[2] = TPair<uint32, bool>(GetFaceIndex(FaceVertexParts[2], CurrentNormalCounter, Normals.Num()), true);
-						}
-
-						Indices.Add(Index);
+						Chunk.Start += Entries[EntryIndex].Offset;
+						Chunk.End += Entries[EntryIndex].Offset;
+						Chunk.Entry = EntryIndex;
+						Chunks.Add(MoveTemp(Chunk));
 					}
 				}
-				continue;
 			}
-
-			// material
-			if (Line[0] == "usemtl")
+			else
 			{
-				if (Indices.Num() > 0)
-				{
-					glTFRuntimeOBJ::FixPrimitive(Primitive, Indices, Vertices, UVs, Normals);
-					RuntimeLOD.Primitives.Add(MoveTemp(Primitive));
-				}
-				Indices.Empty();
-				Primitive = FglTFRuntimePrimitive();
-				Primitive.MaterialName = glTFRuntimeOBJ::GetRemainingString(Line, 1);
-				FglTFRuntimeMaterial Material;
-				glTFRuntimeOBJ::FillMaterial(Asset, Primitive.MaterialName, Material, MaterialsConfig);
+				SplitBlobInChunks(Data, Size, Chunks);
+			}
 
-				if (IsInGameThread())
+			TArray<TArray<FglTFRuntimeOBJObjectInfo>> ChunksObjectInfos;
+			ChunksObjectInfos.AddDefaulted(Chunks.Num());
+
+			ParallelFor(Chunks.Num(), [&](const int32 ChunkIndex)
 				{
-					Primitive.Material = Asset->GetParser()->BuildMaterial(-1, Primitive.MaterialName, Material, MaterialsConfig, false);
-				}
-				else
+					ScanObjectLines(Data, Chunks[ChunkIndex].Start, Chunks[ChunkIndex].End, ChunksObjectInfos[ChunkIndex]);
+				});
+
+			int32 CurrentEntry = -1;
+			for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ChunkIndex++)
+			{
+				if (bMultipleEntries)
 				{
-					FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([&]()
-						{
-							Primitive.Material = Asset->GetParser()->BuildMaterial(-1, Primitive.MaterialName, Material, MaterialsConfig, false);
-						}, TStatId(), nullptr, ENamedThreads::GameThread);
-					FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+					// the whole entry, followed by its objects
+					const int32 ChunkEntry = Chunks[ChunkIndex].Entry;
+					if (ChunkEntry != CurrentEntry)
+					{
+						CurrentEntry = ChunkEntry;
+						FglTFRuntimeOBJObjectInfo EntryInfo;
+						EntryInfo.Name = Entries[CurrentEntry].Name;
+						EntryInfo.Offset = Entries[CurrentEntry].Offset;
+						ObjectInfos.Add(MoveTemp(EntryInfo));
+					}
+
+					for (FglTFRuntimeOBJObjectInfo& ObjectInfo : ChunksObjectInfos[ChunkIndex])
+					{
+						ObjectInfo.Name = Entries[CurrentEntry].Name / ObjectInfo.Name;
+					}
 				}
 
-				continue;
+				ObjectInfos.Append(MoveTemp(ChunksObjectInfos[ChunkIndex]));
 			}
-		}
 
-		if (Indices.Num() > 0)
-		{
-			glTFRuntimeOBJ::FixPrimitive(Primitive, Indices, Vertices, UVs, Normals);
-			RuntimeLOD.Primitives.Add(MoveTemp(Primitive));
-		}
+			if (ObjectInfos.Num() == 0)
+			{
+				// add an empty entry for assets without objects
+				ObjectInfos.AddDefaulted();
+			}
 
-		if (MaterialsConfig.bMergeSectionsByMaterial)
-		{
-			Asset->GetParser()->MergePrimitivesByMaterial(RuntimeLOD.Primitives);
+			RuntimeOBJCacheData->ObjectInfos = ObjectInfos;
 		}
 
-		// cache the mesh
-		RuntimeOBJCacheData->Objects.Add(ObjectName, RuntimeLOD);
-
-		return true;
+		return RuntimeOBJCacheData->ObjectInfos.GetValue();
 	}
 
 	TArray<FString> GetObjectNames(UglTFRuntimeAsset* Asset)
 	{
 		TArray<FString> Names;
-
-		if (!Asset)
+		for (const FglTFRuntimeOBJObjectInfo& ObjectInfo : GetObjectInfos(Asset))
 		{
-			return Names;
+			Names.Add(ObjectInfo.Name);
 		}
+		return Names;
+	}
+}
 
-		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
-
-		TSharedPtr<FglTFRuntimeOBJCacheData> RuntimeOBJCacheData = glTFRuntimeOBJ::GetCacheData(Asset);
-		if (!RuntimeOBJCacheData)
-		{
-			return Names;
-		}
+UglTFRuntimeAsset* UglTFRuntimeOBJFunctionLibrary::LoadOBJAssetFromFilenameMapped(const FString& Filename, const bool bPathRelativeToContent, const FglTFRuntimeConfig& LoaderConfig)
+{
+	FString TruePath = Filename;
+	if (bPathRelativeToContent)
+	{
+		TruePath = FPaths::Combine(FPaths::ProjectContentDir(), Filename);
+	}
 
-		if (RuntimeOBJCacheData->ObjectNames.Num() > 0)
-		{
-			return RuntimeOBJCacheData->ObjectNames;
-		}
+	TUniquePtr<IMappedFileHandle> MappedFileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*TruePath));
+	if (!MappedFileHandle || MappedFileHandle->GetFileSize() <= 0)
+	{
+		// memory mapping not supported (or empty file), fallback to the classic loader
+		FglTFRuntimeConfig BlobLoaderConfig = LoaderConfig;
+		BlobLoaderConfig.bAsBlob = true;
+		return UglTFRuntimeFunctionLibrary::glTFLoadAssetFromFilename(Filename, bPathRelativeToContent, BlobLoaderConfig);
+	}
 
-		for (const TArray<FString>& Line : RuntimeOBJCacheData->GeometryLines)
-		{
-			if (Line[0] == "o")
-			{
-				Names.Add(glTFRuntimeOBJ::GetRemainingString(Line, 1));
-			}
-		}
+	TUniquePtr<IMappedFileRegion> MappedFileRegion(MappedFileHandle->MapRegion(0, MappedFileHandle->GetFileSize()));
+	if (!MappedFileRegion)
+	{
+		return nullptr;
+	}
 
-		if (Names.Num() > 0)
-		{
-			RuntimeOBJCacheData->ObjectNames = Names;
-		}
-		else
-		{
-			// add an empty entry for assets without objects
-			RuntimeOBJCacheData->ObjectNames.Add("");
-		}
+	// the asset blob is just a placeholder, the geometry is parsed directly from the mapped region
+	FglTFRuntimeConfig MappedLoaderConfig = LoaderConfig;
+	MappedLoaderConfig.bAsBlob = true;
+	if (MappedLoaderConfig.OverrideBaseDirectory.IsEmpty())
+	{
+		MappedLoaderConfig.OverrideBaseDirectory = FPaths::GetPath(TruePath);
+	}
 
-		return RuntimeOBJCacheData->ObjectNames;
+	TArray<uint8> PlaceholderBlob;
+	PlaceholderBlob.Add('#');
+	UglTFRuntimeAsset* Asset = UglTFRuntimeFunctionLibrary::glTFLoadAssetFromData(PlaceholderBlob, MappedLoaderConfig);
+	if (!Asset)
+	{
+		return nullptr;
 	}
+
+	TSharedRef<FglTFRuntimeOBJCacheData> RuntimeOBJCacheData = MakeShared<FglTFRuntimeOBJCacheData>();
+	RuntimeOBJCacheData->MappedFilename = TruePath;
+	RuntimeOBJCacheData->MappedFileHandle = MoveTemp(MappedFileHandle);
+	RuntimeOBJCacheData->MappedFileRegion = MoveTemp(MappedFileRegion);
+
+	FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+	Asset->GetParser()->PluginsCacheData.Add("OBJ", RuntimeOBJCacheData);
+
+	return Asset;
 }
 
 TArray<FString> UglTFRuntimeOBJFunctionLibrary::GetOBJObjectNames(UglTFRuntimeAsset* Asset)
@@ -721,6 +3407,11 @@ TArray<FString> UglTFRuntimeOBJFunctionLibrary::GetOBJObjectNames(UglTFRuntimeAs
 	return glTFRuntimeOBJ::GetObjectNames(Asset);
 }
 
+TArray<FglTFRuntimeOBJObjectInfo> UglTFRuntimeOBJFunctionLibrary::GetOBJObjects(UglTFRuntimeAsset* Asset)
+{
+	return glTFRuntimeOBJ::GetObjectInfos(Asset);
+}
+
 void UglTFRuntimeOBJFunctionLibrary::GetOBJObjectNamesAsync(UglTFRuntimeAsset* Asset, const FglTFRuntimeOBJObjectNamesAsync& AsyncCallback)
 {
 	if (!Asset)
@@ -729,7 +3420,7 @@ void UglTFRuntimeOBJFunctionLibrary::GetOBJObjectNamesAsync(UglTFRuntimeAsset* A
 		return;
 	}
 
-	Async(EAsyncExecution::Thread, [Asset, AsyncCallback]()
+	Async(EAsyncExecution::ThreadPool, [Asset, AsyncCallback]()
 		{
 			TArray<FString> Names = glTFRuntimeOBJ::GetObjectNames(Asset);
 			FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([&, AsyncCallback]()
@@ -741,7 +3432,20 @@ void UglTFRuntimeOBJFunctionLibrary::GetOBJObjectNamesAsync(UglTFRuntimeAsset* A
 	);
 }
 
+void UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeMeshLODAsync& AsyncCallback, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+{
+	LoadOBJAsRuntimeLODNativeAsync(Asset, ObjectName, FglTFRuntimeOBJMeshLODNativeAsync::CreateLambda([AsyncCallback](const bool bValid, const FglTFRuntimeMeshLOD& RuntimeLOD)
+		{
+			AsyncCallback.ExecuteIfBound(bValid, RuntimeLOD);
+		}), MaterialsConfig, OBJConfig);
+}
+
 void UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeMeshLODAsync& AsyncCallback, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	LoadOBJAsRuntimeLODAsync(Asset, ObjectName, AsyncCallback, MaterialsConfig, FglTFRuntimeOBJConfig());
+}
+
+void UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODNativeAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeOBJMeshLODNativeAsync& AsyncCallback, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
 {
 	if (!Asset)
 	{
@@ -749,25 +3453,177 @@ void UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODAsync(UglTFRuntimeAsset*
 		return;
 	}
 
-	Async(EAsyncExecution::Thread, [Asset, ObjectName, MaterialsConfig, AsyncCallback]()
+	// run on the thread pool, the game thread is notified without blocking the worker
+	Async(EAsyncExecution::ThreadPool, [Asset, ObjectName, MaterialsConfig, OBJConfig, AsyncCallback]()
 		{
+			// the game thread gets the shared mesh, no copies
 			FglTFRuntimeMeshLOD RuntimeLOD;
-			bool bSuccess = glTFRuntimeOBJ::LoadObjectAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig);
-			FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([&, AsyncCallback]()
+			FglTFRuntimeOBJSharedMeshLODs RuntimeLODs;
+			const bool bSuccess = glTFRuntimeOBJ::LoadObjectAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig, OBJConfig, nullptr, nullptr, 0, &RuntimeLODs);
+			AsyncTask(ENamedThreads::GameThread, [AsyncCallback, bSuccess, RuntimeLODs]()
 				{
-					AsyncCallback.ExecuteIfBound(bSuccess, RuntimeLOD);
-				}, TStatId(), nullptr, ENamedThreads::GameThread);
-			FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+					if (bSuccess)
+					{
+						AsyncCallback.ExecuteIfBound(true, (*RuntimeLODs)[0]);
+					}
+					else
+					{
+						AsyncCallback.ExecuteIfBound(false, FglTFRuntimeMeshLOD());
+					}
+				});
 		}
 	);
 }
 
-bool UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLOD(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+void UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODStreamingAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeOBJMeshLODBatchAsync& AsyncCallback, const int32 BatchTriangles, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+{
+	LoadOBJAsRuntimeLODStreamingNativeAsync(Asset, ObjectName, FglTFRuntimeOBJMeshLODBatchNativeAsync::CreateLambda([AsyncCallback](const bool bValid, const FglTFRuntimeMeshLOD& RuntimeLOD, const bool bLastBatch)
+		{
+			AsyncCallback.ExecuteIfBound(bValid, RuntimeLOD, bLastBatch);
+		}), BatchTriangles, MaterialsConfig, OBJConfig);
+}
+
+void UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODStreamingNativeAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeOBJMeshLODBatchNativeAsync& AsyncCallback, const int32 BatchTriangles, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+{
+	if (!Asset)
+	{
+		AsyncCallback.ExecuteIfBound(false, FglTFRuntimeMeshLOD(), true);
+		return;
+	}
+
+	Async(EAsyncExecution::ThreadPool, [Asset, ObjectName, BatchTriangles, MaterialsConfig, OBJConfig, AsyncCallback]()
+		{
+			// game thread tasks are executed in order, so batches are received in file order
+			auto BatchCallback = [AsyncCallback](FglTFRuntimeMeshLOD& BatchRuntimeLOD)
+				{
+					AsyncTask(ENamedThreads::GameThread, [AsyncCallback, BatchRuntimeLOD = MoveTemp(BatchRuntimeLOD)]()
+						{
+							AsyncCallback.ExecuteIfBound(true, BatchRuntimeLOD, false);
+						});
+				};
+
+			// non-positive BatchTriangles disables streaming, the whole object is delivered as the last batch
+			FglTFRuntimeMeshLOD RuntimeLOD;
+			const bool bSuccess = glTFRuntimeOBJ::LoadObjectAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig, OBJConfig, nullptr, BatchCallback, FMath::Max(BatchTriangles, 0));
+			AsyncTask(ENamedThreads::GameThread, [AsyncCallback, bSuccess, RuntimeLOD = MoveTemp(RuntimeLOD)]()
+				{
+					AsyncCallback.ExecuteIfBound(bSuccess, RuntimeLOD, true);
+				});
+		}
+	);
+}
+
+bool UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODWithStats(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeMeshLOD& RuntimeLOD, FglTFRuntimeOBJLoadStats& Stats, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+{
+	if (!Asset)
+	{
+		Stats = FglTFRuntimeOBJLoadStats();
+		return false;
+	}
+
+	return glTFRuntimeOBJ::LoadObjectAsRuntimeLODWithStats(Asset, ObjectName, RuntimeLOD, Stats, MaterialsConfig, OBJConfig);
+}
+
+bool UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODs(UglTFRuntimeAsset* Asset, const FString& ObjectName, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+{
+	if (!Asset)
+	{
+		return false;
+	}
+
+	return glTFRuntimeOBJ::LoadObjectAsRuntimeLODs(Asset, ObjectName, RuntimeLODs, MaterialsConfig, OBJConfig);
+}
+
+void UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLODsNativeAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeOBJMeshLODsNativeAsync& AsyncCallback, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+{
+	if (!Asset)
+	{
+		AsyncCallback.ExecuteIfBound(false, TArray<FglTFRuntimeMeshLOD>());
+		return;
+	}
+
+	Async(EAsyncExecution::ThreadPool, [Asset, ObjectName, MaterialsConfig, OBJConfig, AsyncCallback]()
+		{
+			// the game thread gets the shared LODs, no copies
+			FglTFRuntimeOBJSharedMeshLODs RuntimeLODs;
+			const bool bSuccess = glTFRuntimeOBJ::LoadObjectAsSharedRuntimeLODs(Asset, ObjectName, RuntimeLODs, MaterialsConfig, OBJConfig);
+			AsyncTask(ENamedThreads::GameThread, [AsyncCallback, bSuccess, RuntimeLODs]()
+				{
+					if (bSuccess)
+					{
+						AsyncCallback.ExecuteIfBound(true, *RuntimeLODs);
+					}
+					else
+					{
+						AsyncCallback.ExecuteIfBound(false, TArray<FglTFRuntimeMeshLOD>());
+					}
+				});
+		}
+	);
+}
+
+FglTFRuntimeStaticMeshConfig UglTFRuntimeOBJFunctionLibrary::GetOBJStaticMeshConfigForLODs(const FglTFRuntimeStaticMeshConfig& StaticMeshConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+{
+	FglTFRuntimeStaticMeshConfig LODsStaticMeshConfig = StaticMeshConfig;
+
+	// the number of triangles scales with the screen area, the screen size with its square root
+	const float ScreenSizeRatio = FMath::Sqrt(FMath::Clamp(OBJConfig.LODTrianglesRatio, 0.01f, 1.0f));
+	for (int32 LODIndex = 1; LODIndex <= OBJConfig.NumGeneratedLODs; LODIndex++)
+	{
+		if (!LODsStaticMeshConfig.LODScreenSize.Contains(LODIndex))
+		{
+			LODsStaticMeshConfig.LODScreenSize.Add(LODIndex, FMath::Pow(ScreenSizeRatio, LODIndex));
+		}
+	}
+
+	return LODsStaticMeshConfig;
+}
+
+bool UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLOD(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
 {
 	if (!Asset)
 	{
 		return false;
 	}
 
-	return glTFRuntimeOBJ::LoadObjectAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig);
+	return glTFRuntimeOBJ::LoadObjectAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig, OBJConfig);
+}
+
+bool UglTFRuntimeOBJFunctionLibrary::LoadOBJAsRuntimeLOD(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	return LoadOBJAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig, FglTFRuntimeOBJConfig());
+}
+
+FglTFRuntimeOBJSharedMeshLOD UglTFRuntimeOBJFunctionLibrary::LoadOBJAsSharedRuntimeLOD(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+{
+	if (!Asset)
+	{
+		return nullptr;
+	}
+
+	FglTFRuntimeMeshLOD RuntimeLOD;
+	FglTFRuntimeOBJSharedMeshLODs RuntimeLODs;
+	if (!glTFRuntimeOBJ::LoadObjectAsRuntimeLOD(Asset, ObjectName, RuntimeLOD, MaterialsConfig, OBJConfig, nullptr, nullptr, 0, &RuntimeLODs))
+	{
+		return nullptr;
+	}
+
+	// keeps the whole chain alive
+	return FglTFRuntimeOBJSharedMeshLOD(RuntimeLODs, &(*RuntimeLODs)[0]);
+}
+
+FglTFRuntimeOBJSharedMeshLODs UglTFRuntimeOBJFunctionLibrary::LoadOBJAsSharedRuntimeLODs(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig)
+{
+	if (!Asset)
+	{
+		return nullptr;
+	}
+
+	FglTFRuntimeOBJSharedMeshLODs RuntimeLODs;
+	if (!glTFRuntimeOBJ::LoadObjectAsSharedRuntimeLODs(Asset, ObjectName, RuntimeLODs, MaterialsConfig, OBJConfig))
+	{
+		return nullptr;
+	}
+
+	return RuntimeLODs;
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeOBJGzip.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+FglTFRuntimeOBJGzipStream::FglTFRuntimeOBJGzipStream(const uint8* InData, const int64 InSize) : Data(InData), Size(InSize), Offset(0), bValid(false), bFinished(false)
+{
+	if (!IsGzip(Data, Size))
+	{
+		return;
+	}
+
+	Stream = MakeUnique<z_stream>();
+	FMemory::Memzero(Stream.Get(), sizeof(z_stream));
+
+	// 16 enables the gzip wrapper
+	bValid = inflateInit2(Stream.Get(), 16 + MAX_WBITS) == Z_OK;
+}
+
+FglTFRuntimeOBJGzipStream::~FglTFRuntimeOBJGzipStream()
+{
+	if (bValid)
+	{
+		inflateEnd(Stream.Get());
+	}
+}
+
+int64 FglTFRuntimeOBJGzipStream::Read(uint8* Output, const int64 OutputSize)
+{
+	if (!bValid)
+	{
+		return -1;
+	}
+
+	int64 NumInflated = 0;
+	while (!bFinished && NumInflated < OutputSize)
+	{
+		if (Stream->avail_in == 0)
+		{
+			if (Offset >= Size)
+			{
+				// truncated
+				return -1;
+			}
+
+			Stream->next_in = const_cast<Bytef*>(Data + Offset);
+			Stream->avail_in = static_cast<uInt>(FMath::Min<int64>(Size - Offset, MAX_int32));
+			Offset += Stream->avail_in;
+		}
+
+		const uInt AvailOut = static_cast<uInt>(FMath::Min<int64>(OutputSize - NumInflated, MAX_int32));
+		Stream->next_out = Output + NumInflated;
+		Stream->avail_out = AvailOut;
+
+		const int Result = inflate(Stream.Get(), Z_NO_FLUSH);
+		NumInflated += AvailOut - Stream->avail_out;
+
+		if (Result == Z_STREAM_END)
+		{
+			const int64 Consumed = Offset - Stream->avail_in;
+			if (IsGzip(Data + Consumed, Size - Consumed))
+			{
+				inflateReset(Stream.Get());
+			}
+			else
+			{
+				// trailing padding is ignored
+				bFinished = true;
+			}
+		}
+		else if (Result != Z_OK && Result != Z_BUF_ERROR)
+		{
+			return -1;
+		}
+	}
+
+	return NumInflated;
+}
+
+int64 FglTFRuntimeOBJGzipStream::GetSizeHint() const
+{
+	if (Size < 18)
+	{
+		return 0;
+	}
+
+	const uint8* Trailer = Data + Size - 4;
+	return static_cast<int64>(Trailer[0]) | (static_cast<int64>(Trailer[1]) << 8) | (static_cast<int64>(Trailer[2]) << 16) | (static_cast<int64>(Trailer[3]) << 24);
+}
+
+bool FglTFRuntimeOBJGzipStream::IsGzip(const uint8* Data, const int64 Size)
+{
+	return Data && Size >= 2 && Data[0] == 0x1f && Data[1] == 0x8b;
+}
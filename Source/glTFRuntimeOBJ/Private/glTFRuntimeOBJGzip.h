@@ -0,0 +1,37 @@
+// Copyright 2023, Roberto De Ioris.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct z_stream_s;
+
+/*
+ * Incremental gzip (RFC 1952) decoder reading from a memory blob.
+ * Concatenated members (as produced by parallel compressors) are decoded as a single stream.
+ */
+class FglTFRuntimeOBJGzipStream
+{
+public:
+	FglTFRuntimeOBJGzipStream(const uint8* InData, const int64 InSize);
+	~FglTFRuntimeOBJGzipStream();
+
+	bool IsValid() const { return bValid; }
+	bool IsFinished() const { return bFinished; }
+
+	// inflates up to OutputSize bytes, returns the number of inflated bytes or -1 for corrupted/truncated data
+	int64 Read(uint8* Output, const int64 OutputSize);
+
+	// uncompressed size stored in the trailer of the last member (modulo 4GB)
+	int64 GetSizeHint() const;
+
+	static bool IsGzip(const uint8* Data, const int64 Size);
+
+private:
+	const uint8* Data;
+	int64 Size;
+	int64 Offset;
+	TUniquePtr<z_stream_s> Stream;
+	bool bValid;
+	bool bFinished;
+};
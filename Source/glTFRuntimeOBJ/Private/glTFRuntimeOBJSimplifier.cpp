@@ -0,0 +1,432 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeOBJSimplifier.h"
+#include "Async/ParallelFor.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// symmetric 4x4 matrix accumulating the squared distances from a set of planes
+struct FglTFRuntimeOBJQuadric
+{
+	double Values[10] = {};
+
+	void AddPlane(const FVector& Normal, const double Distance, const double Weight)
+	{
+		const double A = Normal.X;
+		const double B = Normal.Y;
+		const double C = Normal.Z;
+		const double D = Distance;
+
+		Values[0] += Weight * A * A;
+		Values[1] += Weight * A * B;
+		Values[2] += Weight * A * C;
+		Values[3] += Weight * A * D;
+		Values[4] += Weight * B * B;
+		Values[5] += Weight * B * C;
+		Values[6] += Weight * B * D;
+		Values[7] += Weight * C * C;
+		Values[8] += Weight * C * D;
+		Values[9] += Weight * D * D;
+	}
+
+	void Add(const FglTFRuntimeOBJQuadric& Other)
+	{
+		for (int32 Index = 0; Index < 10; Index++)
+		{
+			Values[Index] += Other.Values[Index];
+		}
+	}
+
+	double Evaluate(const FVector& Position) const
+	{
+		const double X = Position.X;
+		const double Y = Position.Y;
+		const double Z = Position.Z;
+
+		return Values[0] * X * X + 2 * Values[1] * X * Y + 2 * Values[2] * X * Z + 2 * Values[3] * X +
+			Values[4] * Y * Y + 2 * Values[5] * Y * Z + 2 * Values[6] * Y +
+			Values[7] * Z * Z + 2 * Values[8] * Z +
+			Values[9];
+	}
+};
+
+struct FglTFRuntimeOBJCollapse
+{
+	double Error;
+	int32 VertexA;
+	int32 VertexB;
+	// used for discarding stale entries of the heap
+	uint32 VersionA;
+	uint32 VersionB;
+	FVector Target;
+
+	bool operator<(const FglTFRuntimeOBJCollapse& Other) const
+	{
+		return Error < Other.Error;
+	}
+};
+
+namespace glTFRuntimeOBJ
+{
+	// boundary edges are preserved by adding heavily weighted planes perpendicular to them
+	constexpr double BoundaryWeight = 1000;
+
+	void SimplifyPrimitive(const FglTFRuntimePrimitive& Primitive, FglTFRuntimePrimitive& SimplifiedPrimitive, const int32 TargetTriangles)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(glTFRuntimeOBJ_SimplifyPrimitive);
+
+		const int32 NumVertices = Primitive.Positions.Num();
+		const int32 NumTriangles = Primitive.Indices.Num() / 3;
+
+		if (TargetTriangles >= NumTriangles || NumTriangles < 2)
+		{
+			SimplifiedPrimitive = Primitive;
+			return;
+		}
+
+		// weld by position
+		TArray<int32> WeldedVertices;
+		WeldedVertices.SetNumUninitialized(NumVertices);
+		TArray<FVector> Positions;
+		{
+			TMap<FVector, int32> WeldedMap;
+			WeldedMap.Reserve(NumVertices);
+			for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+			{
+				const FVector& Position = Primitive.Positions[VertexIndex];
+				if (const int32* WeldedIndex = WeldedMap.Find(Position))
+				{
+					WeldedVertices[VertexIndex] = *WeldedIndex;
+				}
+				else
+				{
+					WeldedVertices[VertexIndex] = Positions.Add(Position);
+					WeldedMap.Add(Position, WeldedVertices[VertexIndex]);
+				}
+			}
+		}
+
+		const int32 NumWeldedVertices = Positions.Num();
+
+		// welded vertex of each corner (the original vertex is still in Primitive.Indices)
+		TArray<int32> Corners;
+		Corners.SetNumUninitialized(NumTriangles * 3);
+		TArray<bool> AliveTriangles;
+		AliveTriangles.Init(true, NumTriangles);
+		int32 NumAliveTriangles = NumTriangles;
+
+		for (int32 CornerIndex = 0; CornerIndex < NumTriangles * 3; CornerIndex++)
+		{
+			const uint32 VertexIndex = Primitive.Indices[CornerIndex];
+			if (VertexIndex >= static_cast<uint32>(NumVertices))
+			{
+				SimplifiedPrimitive = Primitive;
+				return;
+			}
+			Corners[CornerIndex] = WeldedVertices[VertexIndex];
+		}
+
+		TArray<FglTFRuntimeOBJQuadric> Quadrics;
+		Quadrics.AddDefaulted(NumWeldedVertices);
+		TArray<TArray<int32>> VertexTriangles;
+		VertexTriangles.AddDefaulted(NumWeldedVertices);
+		TMap<uint64, int32> EdgeTriangles;
+
+		auto GetEdgeKey = [](const int32 VertexA, const int32 VertexB) -> uint64
+			{
+				return (static_cast<uint64>(FMath::Min(VertexA, VertexB)) << 32) | static_cast<uint32>(FMath::Max(VertexA, VertexB));
+			};
+
+		for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
+		{
+			const int32* Triangle = &Corners[TriangleIndex * 3];
+			if (Triangle[0] == Triangle[1] || Triangle[1] == Triangle[2] || Triangle[2] == Triangle[0])
+			{
+				AliveTriangles[TriangleIndex] = false;
+				NumAliveTriangles--;
+				continue;
+			}
+
+			const FVector Normal = FVector::CrossProduct(Positions[Triangle[1]] - Positions[Triangle[0]], Positions[Triangle[2]] - Positions[Triangle[0]]);
+			const double Area = Normal.Size() * 0.5;
+			if (Area > 0)
+			{
+				const FVector UnitNormal = Normal.GetSafeNormal();
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					Quadrics[Triangle[Corner]].AddPlane(UnitNormal, -FVector::DotProduct(UnitNormal, Positions[Triangle[0]]), Area);
+				}
+			}
+
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				VertexTriangles[Triangle[Corner]].Add(TriangleIndex);
+
+				const uint64 EdgeKey = GetEdgeKey(Triangle[Corner], Triangle[(Corner + 1) % 3]);
+				if (int32* EdgeTriangle = EdgeTriangles.Find(EdgeKey))
+				{
+					// shared edge
+					*EdgeTriangle = INDEX_NONE;
+				}
+				else
+				{
+					EdgeTriangles.Add(EdgeKey, TriangleIndex);
+				}
+			}
+		}
+
+		for (const TPair<uint64, int32>& Pair : EdgeTriangles)
+		{
+			if (Pair.Value == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const int32 VertexA = static_cast<int32>(Pair.Key >> 32);
+			const int32 VertexB = static_cast<int32>(Pair.Key & 0xFFFFFFFF);
+			const int32* Triangle = &Corners[Pair.Value * 3];
+
+			const FVector TriangleNormal = FVector::CrossProduct(Positions[Triangle[1]] - Positions[Triangle[0]], Positions[Triangle[2]] - Positions[Triangle[0]]).GetSafeNormal();
+			const FVector Edge = Positions[VertexB] - Positions[VertexA];
+			const FVector EdgeNormal = FVector::CrossProduct(Edge, TriangleNormal).GetSafeNormal();
+			if (EdgeNormal.IsZero())
+			{
+				continue;
+			}
+
+			const double Weight = BoundaryWeight * Edge.SizeSquared();
+			const double Distance = -FVector::DotProduct(EdgeNormal, Positions[VertexA]);
+			Quadrics[VertexA].AddPlane(EdgeNormal, Distance, Weight);
+			Quadrics[VertexB].AddPlane(EdgeNormal, Distance, Weight);
+		}
+
+		TArray<uint32> Versions;
+		Versions.AddZeroed(NumWeldedVertices);
+		TArray<bool> AliveVertices;
+		AliveVertices.Init(true, NumWeldedVertices);
+
+		auto ComputeCollapse = [&](const int32 VertexA, const int32 VertexB) -> FglTFRuntimeOBJCollapse
+			{
+				FglTFRuntimeOBJQuadric Quadric = Quadrics[VertexA];
+				Quadric.Add(Quadrics[VertexB]);
+
+				// the optimal position is searched between the endpoints and the midpoint (no matrix inversion, always stable)
+				const FVector Candidates[3] = { Positions[VertexA], Positions[VertexB], (Positions[VertexA] + Positions[VertexB]) * 0.5 };
+
+				FglTFRuntimeOBJCollapse Collapse;
+				Collapse.Error = TNumericLimits<double>::Max();
+				Collapse.VertexA = VertexA;
+				Collapse.VertexB = VertexB;
+				Collapse.VersionA = Versions[VertexA];
+				Collapse.VersionB = Versions[VertexB];
+				for (const FVector& Candidate : Candidates)
+				{
+					const double Error = FMath::Max(Quadric.Evaluate(Candidate), 0.0);
+					if (Error < Collapse.Error)
+					{
+						Collapse.Error = Error;
+						Collapse.Target = Candidate;
+					}
+				}
+				return Collapse;
+			};
+
+		TArray<FglTFRuntimeOBJCollapse> Heap;
+		Heap.Reserve(EdgeTriangles.Num());
+		for (const TPair<uint64, int32>& Pair : EdgeTriangles)
+		{
+			Heap.Add(ComputeCollapse(static_cast<int32>(Pair.Key >> 32), static_cast<int32>(Pair.Key & 0xFFFFFFFF)));
+		}
+		Heap.Heapify();
+
+		// moving Vertex to Target must not flip (or collapse) any of its triangles not shared with Other
+		auto FlipsTriangles = [&](const int32 Vertex, const int32 Other, const FVector& Target) -> bool
+			{
+				for (const int32 TriangleIndex : VertexTriangles[Vertex])
+				{
+					if (!AliveTriangles[TriangleIndex])
+					{
+						continue;
+					}
+
+					const int32* Triangle = &Corners[TriangleIndex * 3];
+					if (Triangle[0] == Other || Triangle[1] == Other || Triangle[2] == Other)
+					{
+						continue;
+					}
+
+					FVector TrianglePositions[3];
+					for (int32 Corner = 0; Corner < 3; Corner++)
+					{
+						TrianglePositions[Corner] = Triangle[Corner] == Vertex ? Target : Positions[Triangle[Corner]];
+					}
+
+					const FVector OldNormal = FVector::CrossProduct(Positions[Triangle[1]] - Positions[Triangle[0]], Positions[Triangle[2]] - Positions[Triangle[0]]);
+					const FVector NewNormal = FVector::CrossProduct(TrianglePositions[1] - TrianglePositions[0], TrianglePositions[2] - TrianglePositions[0]);
+					if (FVector::DotProduct(OldNormal, NewNormal) <= 0)
+					{
+						return true;
+					}
+				}
+				return false;
+			};
+
+		TArray<int32> Neighbours;
+
+		while (NumAliveTriangles > TargetTriangles && Heap.Num() > 0)
+		{
+			FglTFRuntimeOBJCollapse Collapse;
+			Heap.HeapPop(Collapse);
+
+			const int32 VertexA = Collapse.VertexA;
+			const int32 VertexB = Collapse.VertexB;
+
+			if (!AliveVertices[VertexA] || !AliveVertices[VertexB] || Versions[VertexA] != Collapse.VersionA || Versions[VertexB] != Collapse.VersionB)
+			{
+				continue;
+			}
+
+			if (FlipsTriangles(VertexA, VertexB, Collapse.Target) || FlipsTriangles(VertexB, VertexA, Collapse.Target))
+			{
+				continue;
+			}
+
+			// collapse B into A
+			Positions[VertexA] = Collapse.Target;
+			Quadrics[VertexA].Add(Quadrics[VertexB]);
+			AliveVertices[VertexB] = false;
+			Versions[VertexA]++;
+
+			for (const int32 TriangleIndex : VertexTriangles[VertexB])
+			{
+				if (!AliveTriangles[TriangleIndex])
+				{
+					continue;
+				}
+
+				int32* Triangle = &Corners[TriangleIndex * 3];
+				if (Triangle[0] == VertexA || Triangle[1] == VertexA || Triangle[2] == VertexA)
+				{
+					AliveTriangles[TriangleIndex] = false;
+					NumAliveTriangles--;
+					continue;
+				}
+
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					if (Triangle[Corner] == VertexB)
+					{
+						Triangle[Corner] = VertexA;
+					}
+				}
+				VertexTriangles[VertexA].Add(TriangleIndex);
+			}
+			VertexTriangles[VertexB].Empty();
+
+			VertexTriangles[VertexA].RemoveAll([&](const int32 TriangleIndex) { return !AliveTriangles[TriangleIndex]; });
+
+			Neighbours.Reset();
+			for (const int32 TriangleIndex : VertexTriangles[VertexA])
+			{
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					const int32 Neighbour = Corners[TriangleIndex * 3 + Corner];
+					if (Neighbour != VertexA)
+					{
+						Neighbours.AddUnique(Neighbour);
+					}
+				}
+			}
+
+			for (const int32 Neighbour : Neighbours)
+			{
+				Heap.HeapPush(ComputeCollapse(VertexA, Neighbour));
+			}
+		}
+
+		// rebuild the primitive, every (welded vertex, original vertex) pair becomes an output vertex
+		SimplifiedPrimitive = FglTFRuntimePrimitive();
+		SimplifiedPrimitive.Material = Primitive.Material;
+		SimplifiedPrimitive.MaterialName = Primitive.MaterialName;
+		SimplifiedPrimitive.UVs.AddDefaulted(Primitive.UVs.Num());
+
+		const bool bHasNormals = Primitive.Normals.Num() == NumVertices;
+		const bool bHasTangents = Primitive.Tangents.Num() == NumVertices;
+		const bool bHasColors = Primitive.Colors.Num() == NumVertices;
+
+		TMap<uint64, uint32> OutputVertices;
+		SimplifiedPrimitive.Indices.Reserve(NumAliveTriangles * 3);
+
+		for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
+		{
+			if (!AliveTriangles[TriangleIndex])
+			{
+				continue;
+			}
+
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const int32 WeldedVertex = Corners[TriangleIndex * 3 + Corner];
+				const uint32 VertexIndex = Primitive.Indices[TriangleIndex * 3 + Corner];
+				const uint64 VertexKey = (static_cast<uint64>(WeldedVertex) << 32) | VertexIndex;
+
+				if (const uint32* OutputVertex = OutputVertices.Find(VertexKey))
+				{
+					SimplifiedPrimitive.Indices.Add(*OutputVertex);
+					continue;
+				}
+
+				const uint32 OutputVertex = SimplifiedPrimitive.Positions.Add(Positions[WeldedVertex]);
+				if (bHasNormals)
+				{
+					SimplifiedPrimitive.Normals.Add(Primitive.Normals[VertexIndex]);
+				}
+				if (bHasTangents)
+				{
+					SimplifiedPrimitive.Tangents.Add(Primitive.Tangents[VertexIndex]);
+				}
+				if (bHasColors)
+				{
+					SimplifiedPrimitive.Colors.Add(Primitive.Colors[VertexIndex]);
+				}
+				for (int32 UVIndex = 0; UVIndex < Primitive.UVs.Num(); UVIndex++)
+				{
+					if (Primitive.UVs[UVIndex].IsValidIndex(VertexIndex))
+					{
+						SimplifiedPrimitive.UVs[UVIndex].Add(Primitive.UVs[UVIndex][VertexIndex]);
+					}
+				}
+
+				OutputVertices.Add(VertexKey, OutputVertex);
+				SimplifiedPrimitive.Indices.Add(OutputVertex);
+			}
+		}
+	}
+
+	void GenerateLODs(TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, const int32 NumLODs, const float TrianglesRatio)
+	{
+		if (RuntimeLODs.Num() == 0)
+		{
+			return;
+		}
+
+		const float Ratio = FMath::Clamp(TrianglesRatio, 0.01f, 1.0f);
+
+		for (int32 LODIndex = 0; LODIndex < NumLODs; LODIndex++)
+		{
+			// every LOD is simplified from the previous one (cheaper than starting again from LOD0)
+			const FglTFRuntimeMeshLOD& PreviousLOD = RuntimeLODs.Last();
+
+			FglTFRuntimeMeshLOD RuntimeLOD;
+			RuntimeLOD.Primitives.AddDefaulted(PreviousLOD.Primitives.Num());
+
+			ParallelFor(PreviousLOD.Primitives.Num(), [&](const int32 PrimitiveIndex)
+				{
+					const FglTFRuntimePrimitive& Primitive = PreviousLOD.Primitives[PrimitiveIndex];
+					const int32 TargetTriangles = FMath::Max(1, FMath::FloorToInt(Primitive.Indices.Num() / 3 * Ratio));
+					SimplifyPrimitive(Primitive, RuntimeLOD.Primitives[PrimitiveIndex], TargetTriangles);
+				});
+
+			RuntimeLODs.Add(MoveTemp(RuntimeLOD));
+		}
+	}
+}
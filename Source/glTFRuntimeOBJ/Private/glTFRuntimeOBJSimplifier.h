@@ -0,0 +1,19 @@
+// Copyright 2023, Roberto De Ioris.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "glTFRuntimeParser.h"
+
+namespace glTFRuntimeOBJ
+{
+	/*
+	 * Quadric error edge-collapse simplification (Garland-Heckbert) of a triangle list primitive.
+	 * Corners are welded by position, so UV/normal seams do not block collapses, while
+	 * each corner keeps its own attributes.
+	 */
+	void SimplifyPrimitive(const FglTFRuntimePrimitive& Primitive, FglTFRuntimePrimitive& SimplifiedPrimitive, const int32 TargetTriangles);
+
+	// appends NumLODs simplified LODs to RuntimeLODs (that must contain at least LOD0), each one with TrianglesRatio of the previous one triangles
+	void GenerateLODs(TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, const int32 NumLODs, const float TrianglesRatio);
+}
@@ -0,0 +1,145 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeOBJTextureCache.h"
+#include "Containers/List.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/Paths.h"
+
+namespace glTFRuntimeOBJ
+{
+	static TAutoConsoleVariable<int32> CVarTextureCacheBudget(
+		TEXT("glTFRuntimeOBJ.TextureCacheBudgetMB"),
+		1024,
+		TEXT("Memory budget (in MB) of the decoded textures shared by all of the OBJ assets (0 disables the cache)"));
+
+	static FAutoConsoleCommand FlushTextureCacheCommand(
+		TEXT("glTFRuntimeOBJ.FlushTextureCache"),
+		TEXT("Releases the decoded textures shared by all of the OBJ assets"),
+		FConsoleCommandDelegate::CreateStatic(&FlushSharedTextures));
+
+	using FglTFRuntimeOBJTexturesLRU = TDoubleLinkedList<FString>;
+
+	struct FglTFRuntimeOBJSharedTexture
+	{
+		FglTFRuntimeOBJSharedMips Mips;
+		int64 Size = 0;
+		// position in the LRU list (owned by the list)
+		FglTFRuntimeOBJTexturesLRU::TDoubleLinkedListNode* LRUNode = nullptr;
+	};
+
+	struct FglTFRuntimeOBJSharedTextures
+	{
+		FCriticalSection Lock;
+		TMap<FString, FglTFRuntimeOBJSharedTexture> Textures;
+		// most recently used keys first
+		FglTFRuntimeOBJTexturesLRU LRU;
+		int64 TotalSize = 0;
+
+		static FglTFRuntimeOBJSharedTextures& Get()
+		{
+			static FglTFRuntimeOBJSharedTextures SharedTextures;
+			return SharedTextures;
+		}
+
+		// the following must be called with Lock held
+		void Touch(FglTFRuntimeOBJSharedTexture& SharedTexture)
+		{
+			LRU.RemoveNode(SharedTexture.LRUNode, false);
+			LRU.AddHead(SharedTexture.LRUNode);
+		}
+
+		void Trim(const int64 Budget)
+		{
+			while (TotalSize > Budget && LRU.GetTail())
+			{
+				FglTFRuntimeOBJTexturesLRU::TDoubleLinkedListNode* OldestNode = LRU.GetTail();
+				TotalSize -= Textures[OldestNode->GetValue()].Size;
+				Textures.Remove(OldestNode->GetValue());
+				LRU.RemoveNode(OldestNode);
+			}
+		}
+	};
+
+	int64 GetTextureCacheBudget()
+	{
+		return FMath::Max<int64>(CVarTextureCacheBudget.GetValueOnAnyThread(), 0) * 1024 * 1024;
+	}
+
+	FString GetSharedTextureKey(const FString& Filename, const TArray64<uint8>& ImageData, const bool bSRGB, const FString& MaterialsConfigKey)
+	{
+		// the content hash allows sharing the same texture referenced with different relative paths
+		// blocks are chained, so blobs over 4GB are fully hashed
+		constexpr int64 BlockSize = MAX_int32;
+		uint64 Hash = 0;
+		for (int64 Offset = 0; Offset < ImageData.Num(); Offset += BlockSize)
+		{
+			const int64 Length = FMath::Min(BlockSize, ImageData.Num() - Offset);
+			Hash = CityHash64WithSeed(reinterpret_cast<const char*>(ImageData.GetData() + Offset), static_cast<uint32>(Length), Hash);
+		}
+		return FString::Printf(TEXT("%016llx@%lld@%s@%d@%s"), Hash, ImageData.Num(), *FPaths::GetExtension(Filename).ToLower(), bSRGB ? 1 : 0, *MaterialsConfigKey);
+	}
+
+	FglTFRuntimeOBJSharedMips FindSharedTexture(const FString& Key)
+	{
+		FglTFRuntimeOBJSharedTextures& SharedTextures = FglTFRuntimeOBJSharedTextures::Get();
+		FScopeLock Lock(&SharedTextures.Lock);
+
+		// the budget could have been lowered
+		SharedTextures.Trim(GetTextureCacheBudget());
+
+		if (FglTFRuntimeOBJSharedTexture* SharedTexture = SharedTextures.Textures.Find(Key))
+		{
+			SharedTextures.Touch(*SharedTexture);
+			return SharedTexture->Mips;
+		}
+
+		return nullptr;
+	}
+
+	FglTFRuntimeOBJSharedMips AddSharedTexture(const FString& Key, TArray<FglTFRuntimeMipMap>&& Mips)
+	{
+		int64 Size = 0;
+		for (const FglTFRuntimeMipMap& Mip : Mips)
+		{
+			Size += Mip.Pixels.Num();
+		}
+
+		FglTFRuntimeOBJSharedMips SharedMips = MakeShared<TArray<FglTFRuntimeMipMap>, ESPMode::ThreadSafe>(MoveTemp(Mips));
+
+		const int64 Budget = GetTextureCacheBudget();
+		if (Size > Budget)
+		{
+			return SharedMips;
+		}
+
+		FglTFRuntimeOBJSharedTextures& SharedTextures = FglTFRuntimeOBJSharedTextures::Get();
+		FScopeLock Lock(&SharedTextures.Lock);
+
+		if (FglTFRuntimeOBJSharedTexture* SharedTexture = SharedTextures.Textures.Find(Key))
+		{
+			SharedTextures.Touch(*SharedTexture);
+			return SharedTexture->Mips;
+		}
+
+		SharedTextures.Trim(Budget - Size);
+
+		FglTFRuntimeOBJSharedTexture& SharedTexture = SharedTextures.Textures.Add(Key);
+		SharedTexture.Mips = SharedMips;
+		SharedTexture.Size = Size;
+		SharedTextures.LRU.AddHead(Key);
+		SharedTexture.LRUNode = SharedTextures.LRU.GetHead();
+		SharedTextures.TotalSize += Size;
+
+		return SharedMips;
+	}
+
+	void FlushSharedTextures()
+	{
+		FglTFRuntimeOBJSharedTextures& SharedTextures = FglTFRuntimeOBJSharedTextures::Get();
+		FScopeLock Lock(&SharedTextures.Lock);
+		SharedTextures.Textures.Empty();
+		SharedTextures.LRU.Empty();
+		SharedTextures.TotalSize = 0;
+	}
+}
@@ -0,0 +1,26 @@
+// Copyright 2023, Roberto De Ioris.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "glTFRuntimeParser.h"
+
+using FglTFRuntimeOBJSharedMips = TSharedPtr<const TArray<FglTFRuntimeMipMap>, ESPMode::ThreadSafe>;
+
+namespace glTFRuntimeOBJ
+{
+	/*
+	 * Process-wide cache of decoded textures shared by all of the OBJ assets.
+	 * Entries are keyed by content and decoding options (see GetSharedTextureKey) and the least recently
+	 * used ones are evicted when the glTFRuntimeOBJ.TextureCacheBudgetMB budget is exceeded.
+	 * Evicted mips stay alive as long as someone references them.
+	 */
+	FString GetSharedTextureKey(const FString& Filename, const TArray64<uint8>& ImageData, const bool bSRGB, const FString& MaterialsConfigKey);
+
+	FglTFRuntimeOBJSharedMips FindSharedTexture(const FString& Key);
+
+	// returns the already cached mips if another thread added the same key in the meantime
+	FglTFRuntimeOBJSharedMips AddSharedTexture(const FString& Key, TArray<FglTFRuntimeMipMap>&& Mips);
+
+	void FlushSharedTextures();
+}
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "glTFRuntimeAsset.h"
+#include "glTFRuntimeOBJFunctionLibrary.h"
 #include "glTFRuntimeOBJAssetActor.generated.h"
 
 UCLASS()
@@ -30,6 +31,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|OBJ")
 	FglTFRuntimeStaticMeshConfig StaticMeshConfig;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|OBJ")
+	FglTFRuntimeOBJConfig OBJConfig;
+
 	UFUNCTION(BlueprintNativeEvent, Category = "glTFRuntime|OBJ", meta = (DisplayName = "On StaticMeshComponent Created"))
 	void ReceiveOnStaticMeshComponentCreated(UStaticMeshComponent* StaticMeshComponent);
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "glTFRuntimeAsset.h"
+#include "glTFRuntimeOBJFunctionLibrary.h"
 #include "glTFRuntimeOBJAssetActorAsync.generated.h"
 
 UCLASS()
@@ -30,6 +31,17 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|OBJ")
 	FglTFRuntimeStaticMeshConfig StaticMeshConfig;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|OBJ")
+	FglTFRuntimeOBJConfig OBJConfig;
+
+	// Maximum number of objects loaded concurrently (0 = number of cores)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = 0), Category = "glTFRuntime|OBJ")
+	int32 MaxConcurrentLoads;
+
+	// When greater than 0, objects are displayed progressively in batches of this many triangles (one component per batch, no generated LODs)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = 0), Category = "glTFRuntime|OBJ")
+	int32 StreamingBatchTriangles;
+
 	UFUNCTION(BlueprintNativeEvent, Category = "glTFRuntime|OBJ", meta = (DisplayName = "On StaticMeshComponent Created"))
 	void ReceiveOnStaticMeshComponentCreated(UStaticMeshComponent* StaticMeshComponent);
 
@@ -40,17 +52,17 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"), Category = "glTFRuntime|OBJ")
 	USceneComponent* AssetRoot;
 
-	TMap<UStaticMeshComponent*, FString> MeshesToLoad;
+	TArray<TPair<UStaticMeshComponent*, FString>> MeshesToLoad;
 
-	void LoadNextMeshAsync();
+	int32 NumLoadsInFlight;
 
-	// this is safe to share between game and async threads because everything is sequential
-	UStaticMeshComponent* CurrentPrimitiveComponent;
+	void LoadNextMeshesAsync();
 
 	UFUNCTION()
 	void LoadObjectsAsync(const TArray<FString>& Names);
 
-	UFUNCTION()
-	void LoadStaticMeshAsync(const bool bValid, const FglTFRuntimeMeshLOD& RuntimeLOD);
+	void LoadStaticMeshAsync(const bool bValid, const TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, UStaticMeshComponent* StaticMeshComponent);
+
+	void LoadStaticMeshBatchAsync(const bool bValid, const FglTFRuntimeMeshLOD& RuntimeLOD, const bool bLastBatch, UStaticMeshComponent* StaticMeshComponent);
 
 };
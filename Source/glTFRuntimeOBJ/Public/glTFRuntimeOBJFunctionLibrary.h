@@ -8,6 +8,193 @@
 #include "glTFRuntimeOBJFunctionLibrary.generated.h"
 
 DECLARE_DYNAMIC_DELEGATE_OneParam(FglTFRuntimeOBJObjectNamesAsync, const TArray<FString>&, ObjectNames);
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FglTFRuntimeOBJMeshLODBatchAsync, const bool, bValid, const FglTFRuntimeMeshLOD&, RuntimeLOD, const bool, bLastBatch);
+DECLARE_DELEGATE_TwoParams(FglTFRuntimeOBJMeshLODNativeAsync, const bool, const FglTFRuntimeMeshLOD&);
+DECLARE_DELEGATE_ThreeParams(FglTFRuntimeOBJMeshLODBatchNativeAsync, const bool, const FglTFRuntimeMeshLOD&, const bool);
+DECLARE_DELEGATE_TwoParams(FglTFRuntimeOBJMeshLODsNativeAsync, const bool, const TArray<FglTFRuntimeMeshLOD>&);
+
+// immutable meshes shared with the asset memory cache
+using FglTFRuntimeOBJSharedMeshLOD = TSharedPtr<const FglTFRuntimeMeshLOD, ESPMode::ThreadSafe>;
+using FglTFRuntimeOBJSharedMeshLODs = TSharedPtr<const TArray<FglTFRuntimeMeshLOD>, ESPMode::ThreadSafe>;
+
+USTRUCT(BlueprintType)
+struct FglTFRuntimeOBJConfig
+{
+	GENERATED_BODY()
+
+	// Merge face corners sharing the same v/vt/vn triple into a single vertex
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|OBJ")
+	bool bDeduplicateVertices;
+
+	// Generate normals (honoring "s" smoothing groups) for the face corners without a vn, instead of leaving them to the mesh build
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|OBJ")
+	bool bGenerateNormals;
+
+	// Generate tangents from the UVs (requires UVs and normals)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|OBJ")
+	bool bGenerateTangents;
+
+	// When set, built objects are stored in (and loaded from) binary files in this directory
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|OBJ")
+	FString DiskCacheDirectory;
+
+	// Keep built objects in the asset memory cache (shared by all of the loads), when disabled every load builds its own mesh and gets it without copies
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|OBJ")
+	bool bCacheObjects;
+
+	// Number of simplified LODs generated after LOD0 by the LOD chain functions (0 = disabled)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|OBJ", meta = (ClampMin = 0))
+	int32 NumGeneratedLODs;
+
+	// Fraction of triangles each generated LOD keeps from the previous one
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|OBJ", meta = (ClampMin = 0.01, ClampMax = 1))
+	float LODTrianglesRatio;
+
+	FglTFRuntimeOBJConfig()
+	{
+		bDeduplicateVertices = true;
+		bGenerateNormals = false;
+		bGenerateTangents = false;
+		bCacheObjects = true;
+		NumGeneratedLODs = 0;
+		LODTrianglesRatio = 0.5f;
+	}
+};
+
+/*
+ * Stats of a single object load. Times are in seconds and only cover the stages executed by that load
+ * (geometry parsing and material libraries loading happen once per asset).
+ */
+USTRUCT(BlueprintType)
+struct FglTFRuntimeOBJLoadStats
+{
+	GENERATED_BODY()
+
+	// Size of the geometry source
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int64 BytesRead;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int32 NumLines;
+
+	// The asset geometry has been parsed (by this or a previous load), NumLines and NumSource* are zero otherwise (disk cache hits skip parsing)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	bool bGeometryParsed;
+
+	// v/vt/vn entries of the whole asset
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int32 NumSourceVertices;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int32 NumSourceUVs;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int32 NumSourceNormals;
+
+	// The object was served by a cache, so the build stage times are zero
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	bool bFromMemoryCache;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	bool bFromDiskCache;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int32 NumPrimitives;
+
+	// Face corners, before merging the ones sharing the same v/vt/vn triple
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int32 NumVerticesBeforeDeduplication;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int32 NumVertices;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int32 NumTriangles;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int32 NumMaterials;
+
+	// Textures found in the process-wide texture cache are not decoded again
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int32 NumTexturesDecoded;
+
+	// Lines splitting, attributes parsing and object indexing
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	float ParseTime;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	float MaterialLibrariesTime;
+
+	// Faces parsing and triangulation
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	float BuildTime;
+
+	// Vertices emission and deduplication
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	float FixPrimitivesTime;
+
+	// Materials parsing (including TexturesTime)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	float FillMaterialsTime;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	float TexturesTime;
+
+	// Time spent waiting for the game thread to build the material instances
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	float BuildMaterialsTime;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	float DiskCacheTime;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	float TotalTime;
+
+	FglTFRuntimeOBJLoadStats()
+	{
+		BytesRead = 0;
+		NumLines = 0;
+		NumSourceVertices = 0;
+		NumSourceUVs = 0;
+		NumSourceNormals = 0;
+		bGeometryParsed = false;
+		bFromMemoryCache = false;
+		bFromDiskCache = false;
+		NumPrimitives = 0;
+		NumVerticesBeforeDeduplication = 0;
+		NumVertices = 0;
+		NumTriangles = 0;
+		NumMaterials = 0;
+		NumTexturesDecoded = 0;
+		ParseTime = 0.0f;
+		MaterialLibrariesTime = 0.0f;
+		BuildTime = 0.0f;
+		FixPrimitivesTime = 0.0f;
+		FillMaterialsTime = 0.0f;
+		TexturesTime = 0.0f;
+		BuildMaterialsTime = 0.0f;
+		DiskCacheTime = 0.0f;
+		TotalTime = 0.0f;
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FglTFRuntimeOBJObjectInfo
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	FString Name;
+
+	// Byte offset of the "o" line in the geometry source
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|OBJ")
+	int64 Offset;
+
+	FglTFRuntimeOBJObjectInfo()
+	{
+		Offset = 0;
+	}
+};
 
 /**
  * 
@@ -18,16 +205,73 @@ class GLTFRUNTIMEOBJ_API UglTFRuntimeOBJFunctionLibrary : public UBlueprintFunct
 	GENERATED_BODY()
 
 public:
+	/**
+	 * Memory-maps a local OBJ file and returns an asset parsing directly from the mapping,
+	 * avoiding to keep a full in-memory copy of the file.
+	 * Gzip files (.obj.gz) are inflated from the mapping, which is released afterwards, and the inflated text stays in memory
+	 * as long as the asset. The geometry is parsed while inflating, unless the first call is an objects names scan or a disk cache lookup.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "bPathRelativeToContent,LoaderConfig", AutoCreateRefTerm = "LoaderConfig"), Category = "glTFRuntime|OBJ")
+	static UglTFRuntimeAsset* LoadOBJAssetFromFilenameMapped(const FString& Filename, const bool bPathRelativeToContent, const FglTFRuntimeConfig& LoaderConfig);
+
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|OBJ")
 	static TArray<FString> GetOBJObjectNames(UglTFRuntimeAsset* Asset);
 
+	// Objects names and offsets, found by scanning the raw geometry for "o" lines (no parsing and no material loading)
+	// Archives with multiple .obj files list each file followed by its objects as "File/Object",
+	// "" (not listed) is still the unnamed object of the first file
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|OBJ")
+	static TArray<FglTFRuntimeOBJObjectInfo> GetOBJObjects(UglTFRuntimeAsset* Asset);
+
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|OBJ")
 	static void GetOBJObjectNamesAsync(UglTFRuntimeAsset* Asset, const FglTFRuntimeOBJObjectNamesAsync& AsyncCallback);
 
-	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig", AutoCreateRefTerm = "MaterialsConfig"), Category = "glTFRuntime|OBJ")
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig,OBJConfig", AutoCreateRefTerm = "MaterialsConfig,OBJConfig"), Category = "glTFRuntime|OBJ")
+	static bool LoadOBJAsRuntimeLOD(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig);
+
+	// C++ overload (without OBJConfig) kept for existing callers, uses the default FglTFRuntimeOBJConfig
 	static bool LoadOBJAsRuntimeLOD(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
 
-	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig", AutoCreateRefTerm = "MaterialsConfig"), Category = "glTFRuntime|OBJ")
+	// Same as LoadOBJAsRuntimeLOD but also reports the stats of the load
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig,OBJConfig", AutoCreateRefTerm = "MaterialsConfig,OBJConfig"), Category = "glTFRuntime|OBJ")
+	static bool LoadOBJAsRuntimeLODWithStats(UglTFRuntimeAsset* Asset, const FString& ObjectName, FglTFRuntimeMeshLOD& RuntimeLOD, FglTFRuntimeOBJLoadStats& Stats, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig);
+
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig,OBJConfig", AutoCreateRefTerm = "MaterialsConfig,OBJConfig"), Category = "glTFRuntime|OBJ")
+	static void LoadOBJAsRuntimeLODAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeMeshLODAsync& AsyncCallback, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig);
+
+	// C++ overload (without OBJConfig) kept for existing callers, uses the default FglTFRuntimeOBJConfig
 	static void LoadOBJAsRuntimeLODAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeMeshLODAsync& AsyncCallback, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+
+	// C++ version of LoadOBJAsRuntimeLODAsync, multiple calls are executed concurrently on the thread pool
+	static void LoadOBJAsRuntimeLODNativeAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeOBJMeshLODNativeAsync& AsyncCallback, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig);
+
+	/**
+	 * Progressive version of LoadOBJAsRuntimeLODAsync: the object is delivered in batches of (roughly) BatchTriangles triangles
+	 * as soon as they are built. The last call has bLastBatch set (its LOD can be empty).
+	 * BatchTriangles <= 0 disables streaming: the whole object is delivered in a single (last) batch.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig,OBJConfig", AutoCreateRefTerm = "MaterialsConfig,OBJConfig"), Category = "glTFRuntime|OBJ")
+	static void LoadOBJAsRuntimeLODStreamingAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeOBJMeshLODBatchAsync& AsyncCallback, const int32 BatchTriangles, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig);
+
+	/**
+	 * Loads the object as LOD0 followed by OBJConfig.NumGeneratedLODs simplified LODs (quadric edge collapse).
+	 */
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig,OBJConfig", AutoCreateRefTerm = "MaterialsConfig,OBJConfig"), Category = "glTFRuntime|OBJ")
+	static bool LoadOBJAsRuntimeLODs(UglTFRuntimeAsset* Asset, const FString& ObjectName, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig);
+
+	// C++ version of LoadOBJAsRuntimeLOD returning the (immutable) cached mesh instead of a copy, null on failure
+	static FglTFRuntimeOBJSharedMeshLOD LoadOBJAsSharedRuntimeLOD(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig);
+
+	// C++ version of LoadOBJAsRuntimeLODs returning the (immutable) cached LODs chain instead of a copy, null on failure
+	static FglTFRuntimeOBJSharedMeshLODs LoadOBJAsSharedRuntimeLODs(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig);
+
+	// C++ asynchronous version of LoadOBJAsRuntimeLODs, the LODs are generated on the thread pool
+	static void LoadOBJAsRuntimeLODsNativeAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeOBJMeshLODsNativeAsync& AsyncCallback, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig);
+
+	// Returns a copy of StaticMeshConfig with screen sizes for the generated LODs (the ones already specified are kept)
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|OBJ")
+	static FglTFRuntimeStaticMeshConfig GetOBJStaticMeshConfigForLODs(const FglTFRuntimeStaticMeshConfig& StaticMeshConfig, const FglTFRuntimeOBJConfig& OBJConfig);
+
+	static void LoadOBJAsRuntimeLODStreamingNativeAsync(UglTFRuntimeAsset* Asset, const FString& ObjectName, const FglTFRuntimeOBJMeshLODBatchNativeAsync& AsyncCallback, const int32 BatchTriangles, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeOBJConfig& OBJConfig);
 	
 };
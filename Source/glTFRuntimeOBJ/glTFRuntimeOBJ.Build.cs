@@ -36,6 +36,8 @@ public class glTFRuntimeOBJ : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"Json",
+				"JsonUtilities",
 				"glTFRuntime"
 				// ... add private dependencies that you statically link with here ...	
 			}
@@ -51,6 +53,9 @@ public class glTFRuntimeOBJ : ModuleRules
             PrivateDependencyModuleNames.Add("GeometricObjects");
         }
 
+		// gzip (.obj.gz/.mtl.gz) support
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
 
         DynamicallyLoadedModuleNames.AddRange(
 			new string[]